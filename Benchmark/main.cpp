@@ -0,0 +1,572 @@
+// Headless benchmark for the game core, the scoring kernels, the dictionary and the statistics store.
+// Plays simulated games with different strategies and reports games/sec, ns per CheckGuess,
+// heap allocations per game and how many guesses the games took. It first checks that the batch
+// scoring kernel gives exactly CheckGuess's patterns, that damaged dictionary files are rejected
+// (using temporary bench-dict.* files) and that the statistics store recovers from crashes (using
+// temporary bench-recovery.* files), and exits with 1 if any check fails.
+//
+// Windows: build the Benchmark project (Release).
+// Linux:   g++ -std=c++14 -O2 -pthread -I../Codeholics main.cpp ../Codeholics/Scoring.cpp ../Codeholics/Dictionary.cpp
+//              ../Codeholics/MappedFile.cpp ../Codeholics/GameCore.cpp ../Codeholics/Solver.cpp ../Codeholics/ThreadPool.cpp
+//              ../Codeholics/StatsStore.cpp ../Codeholics/ToolWords.cpp ../Codeholics/AllocCounter.cpp -o bench
+//
+// Usage: bench [--dict words5.cdict] [--strategy random|greedy|solver|all] [--games N] [--seed S] [--stats N]
+//
+// --stats N records N games in a temporary statistics store (bench-stats.*) and times opening and queries.
+
+#include "GameCore.h"  // Game rules without drawing or input
+#include "Absurdle.h"  // For timing the adversarial mode
+#include "Solver.h"    // For the solver strategy
+#include "StatsStore.h" // For timing the statistics store
+#include "ToolWords.h" // Word lists from a dictionary file or the built-in list
+#include "AllocCounter.h" // The report shows allocations per game
+#include <algorithm>   // For std::max
+#include <chrono>      // For timing
+#include <cstddef>     // For offsetof in the self-checks
+#include <cstdio>      // For printing the report
+#include <cstdlib>     // For strtoull
+#include <cstring>     // For strcmp
+#include <fstream>     // For writing damaged dictionaries and statistics
+#include <numeric>     // For std::iota
+#include <random>      // For picking guesses
+#include <string>      // For command line arguments
+#include <thread>      // For yielding while the solver works
+#include <vector>      // For candidate lists
+
+typedef std::chrono::steady_clock Clock;
+
+static double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Everything the strategies may pick their guesses from
+struct BenchWords {
+    GameWords game;
+    SolverWords solver;
+};
+
+// A way of playing the game
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+    virtual const char* Name() const = 0;
+    virtual void NewGame() {}
+    virtual const char* NextGuess(const ClassicGame& game) = 0;  // WORD_LENGTH letters
+};
+
+// Guess random allowed words (measures the raw cost of a guess)
+class RandomStrategy : public Strategy {
+public:
+    RandomStrategy(const BenchWords& words, uint32_t seed) : words(words), random(seed) {}
+    const char* Name() const override { return "random"; }
+
+    const char* NextGuess(const ClassicGame&) override {
+        std::uniform_int_distribution<size_t> pick(0, words.solver.guessCount - 1);
+        return words.solver.guesses + pick(random) * WORD_LENGTH;
+    }
+
+private:
+    BenchWords words;
+    std::mt19937 random;
+};
+
+// Guess a random answer that still matches every feedback so far
+class GreedyStrategy : public Strategy {
+public:
+    GreedyStrategy(const BenchWords& words, uint32_t seed)
+        : answers(words.game.answers), random(seed), candidates(answers.count), patterns(answers.count) {}
+    const char* Name() const override { return "greedy"; }
+
+    void NewGame() override {
+        candidates.resize(answers.count);
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+
+    const char* NextGuess(const ClassicGame& game) override {
+        if (game.GuessCount() > 0) {
+            // Keep the candidates that give the same feedback for the last guess
+            CheckGuessBatch<WORD_LENGTH>(game.Guess(game.GuessCount() - 1), answers, patterns.data());
+            const Pattern<WORD_LENGTH> feedback = game.Feedback(game.GuessCount() - 1, 0);
+            size_t kept = 0;
+            for (uint32_t candidate : candidates) {
+                if (patterns[candidate] == feedback) candidates[kept++] = candidate;
+            }
+            candidates.resize(kept);
+        }
+
+        std::uniform_int_distribution<size_t> pick(0, candidates.size() - 1);
+        uint32_t index = candidates[pick(random)];
+        for (int i = 0; i < WORD_LENGTH; i++) guess[i] = (char)answers.letters[i * answers.stride + index];
+        return guess;
+    }
+
+private:
+    WordPlanes answers;
+    std::mt19937 random;
+    std::vector<uint32_t> candidates;  // Indices of answers that are still possible
+    std::vector<Pattern<WORD_LENGTH>> patterns;  // Feedback of the last guess for every answer
+    char guess[WORD_LENGTH];
+};
+
+// Ask the hint solver and wait for its final answer
+class SolverStrategy : public Strategy {
+public:
+    explicit SolverStrategy(const BenchWords& words) : solver(words.solver, pool) {}
+    const char* Name() const override { return "solver"; }
+
+    const char* NextGuess(const ClassicGame& game) override {
+        game.History(0, guesses, feedbacks);
+        solver.RequestHint(guesses, feedbacks);
+        Hint hint = solver.CurrentHint();
+        while (!hint.finished) {
+            std::this_thread::yield();
+            hint = solver.CurrentHint();
+        }
+        hint.guess.copy(guess, WORD_LENGTH);
+        return guess;
+    }
+
+private:
+    ThreadPool pool;                   // Declared before the solver so it outlives it
+    Solver<WORD_LENGTH> solver;
+    std::vector<std::string> guesses;  // History handed to the solver
+    std::vector<Pattern<WORD_LENGTH>> feedbacks;
+    char guess[WORD_LENGTH];
+};
+
+// Play `games` games and print one line of results
+static void RunStrategy(Strategy& strategy, const BenchWords& words, size_t games, uint32_t seed) {
+    ClassicGame game(words.game, seed);
+    size_t histogram[ClassicGame::GUESSES + 1] = { 0 };  // [0] = lost, [n] = won in n guesses
+    size_t totalGuesses = 0;
+
+    const size_t allocationsBefore = AllocationCount();
+    const Clock::time_point start = Clock::now();
+    for (size_t g = 0; g < games; g++) {
+        game.NewGame();
+        strategy.NewGame();
+        while (!game.IsOver()) {
+            if (game.Submit(strategy.NextGuess(game)) != GuessResult::Accepted) break;
+        }
+        histogram[game.IsWon() ? game.GuessCount() : 0]++;
+        totalGuesses += game.GuessCount();
+    }
+    const double seconds = SecondsSince(start);
+    const size_t allocations = AllocationCount() - allocationsBefore;
+
+    printf("%-8s %10zu %12.0f %12.2f %6.3f", strategy.Name(), games, games / seconds, (double)allocations / games, (double)totalGuesses / games);
+    for (int i = 1; i <= ClassicGame::GUESSES; i++) printf(" %6.2f%%", 100.0 * histogram[i] / games);
+    printf(" %6.2f%%\n", 100.0 * histogram[0] / games);
+}
+
+// Count the answers CheckGuessBatch scores differently from CheckGuess. The words use only four
+// letters, so most of them repeat letters and hit every present/absent case of the kernels.
+template <int L>
+static size_t CountKernelMismatches(std::mt19937& random) {
+    std::vector<std::string> answers(1000 + L, std::string(L, ' '));  // Not a whole number of blocks, so the last block is partial
+    for (std::string& word : answers) {
+        for (char& letter : word) letter = (char)('A' + random() % 4);
+    }
+    const PackedWords packed = PackWords<L>(answers);
+    std::vector<Pattern<L>> patterns(packed.count);
+
+    size_t mismatches = 0;
+    std::string guess(L, ' ');
+    for (int g = 0; g < 200; g++) {
+        for (char& letter : guess) letter = (char)('A' + random() % 5);  // Sometimes a letter no answer has
+        CheckGuessBatch<L>(guess.c_str(), packed.View(), patterns.data());
+        for (size_t a = 0; a < answers.size(); a++) {
+            if (patterns[a] != CheckGuess<L>(guess.c_str(), answers[a].c_str())) {
+                if (mismatches == 0) fprintf(stderr, "CheckGuessBatch<%d> scores %s against %s wrong\n", L, guess.c_str(), answers[a].c_str());
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Check that the batch kernel this CPU uses gives exactly CheckGuess's results for every word length
+static bool CheckKernels(uint32_t seed) {
+    std::mt19937 random(seed);
+    const size_t mismatches = CountKernelMismatches<4>(random) + CountKernelMismatches<5>(random) + CountKernelMismatches<6>(random)
+        + CountKernelMismatches<7>(random) + CountKernelMismatches<8>(random);
+    if (mismatches > 0) {
+        fprintf(stderr, "Kernel self-check FAILED: %zu patterns differ from CheckGuess (%s)\n", mismatches, ScoringKernelName());
+        return false;
+    }
+    printf("Kernel self-check: %s matches CheckGuess for %d to %d letters\n\n", ScoringKernelName(), MIN_WORD_LENGTH, MAX_WORD_LENGTH);
+    return true;
+}
+
+// Build a dictionary from the built-in words, then check that it opens and finds every word, and
+// that damaged copies of it are rejected instead of being trusted
+static bool CheckDictionaryValidation() {
+    const std::string wordsPath = "bench-dict.txt";
+    const std::string goodPath = "bench-dict.cdict";
+    const std::string badPath = "bench-dict-bad.cdict";
+    {
+        std::ofstream list(wordsPath, std::ios::trunc);
+        for (const std::string& word : BuiltInWords(WORD_LENGTH)) list << word << "\n";
+    }
+    std::string error;
+    bool ok = BuildDictionary(wordsPath, "", goodPath, error);
+    std::vector<char> image;
+    if (ok) {
+        std::ifstream input(goodPath, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        Dictionary dictionary;
+        ok = dictionary.Open(goodPath, WORD_LENGTH, error);
+        for (const std::string& word : BuiltInWords(WORD_LENGTH)) ok = ok && dictionary.Contains(word);
+        if (ok && dictionary.Contains(std::string(WORD_LENGTH, 'Q'))) {
+            error = "Accepts a word that is not in it";
+            ok = false;
+        }
+    }
+
+    // Write a damaged copy (header field at `offset` set to `value`, then cut to `size` bytes) and try to open it
+    size_t rejected = 0;
+    auto expectRejected = [&](const char* damage, size_t offset, uint64_t value, size_t valueSize, size_t size, int wordLength) {
+        if (!ok) return;
+        std::vector<char> bad(image.begin(), image.begin() + std::min(size, image.size()));
+        if (valueSize > 0) memcpy(&bad[offset], &value, valueSize);  // Little-endian like the file
+        {
+            std::ofstream output(badPath, std::ios::binary | std::ios::trunc);
+            output.write(bad.data(), (std::streamsize)bad.size());
+        }
+        Dictionary dictionary;
+        std::string openError;
+        if (dictionary.Open(badPath, wordLength, openError)) {
+            error = std::string("Opens a dictionary with ") + damage;
+            ok = false;
+        }
+        rejected++;
+    };
+    const size_t full = image.size();
+    expectRejected("a bad magic number", offsetof(DictionaryHeader, magic), 0x12345678, 4, full, WORD_LENGTH);
+    expectRejected("another version", offsetof(DictionaryHeader, version), DICTIONARY_VERSION - 1, 4, full, WORD_LENGTH);
+    expectRejected("a cut-off header", 0, 0, 0, sizeof(DictionaryHeader) - 1, WORD_LENGTH);
+    expectRejected("cut-off word lists", 0, 0, 0, full - 1, WORD_LENGTH);
+    expectRejected("words of another length", 0, 0, 0, full, WORD_LENGTH + 1);
+    expectRejected("a wrapping answer offset", offsetof(DictionaryHeader, answerOffset), ~0ull - 63, 8, full, WORD_LENGTH);
+    expectRejected("answer planes not padded to a block", offsetof(DictionaryHeader, answerStride), WORD_BLOCK + 1, 4, full, WORD_LENGTH);
+    expectRejected("no hash slots", offsetof(DictionaryHeader, slotCount), 0, 4, full, WORD_LENGTH);
+
+    std::remove(wordsPath.c_str());
+    std::remove(goodPath.c_str());
+    std::remove(badPath.c_str());
+    if (!ok) {
+        fprintf(stderr, "Dictionary self-check FAILED: %s\n", error.c_str());
+        return false;
+    }
+    printf("Dictionary self-check: %zu damaged files rejected\n\n", rejected);
+    return true;
+}
+
+// Time CheckGuessBatch for L-letter words on a list of random words the size of a large dictionary
+template <int L>
+static unsigned TimeBatchLength(std::mt19937& random) {
+    std::vector<std::string> randomWords(16384, std::string(L, ' '));
+    for (std::string& word : randomWords) {
+        for (char& letter : word) letter = (char)('A' + random() % 26);
+    }
+    const PackedWords packed = PackWords<L>(randomWords);
+    std::vector<Pattern<L>> patterns(packed.count);
+
+    const size_t batches = 1000;
+    unsigned checksum = 0;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < batches; i++) {
+        CheckGuessBatch<L>(randomWords[i % randomWords.size()].c_str(), packed.View(), patterns.data());
+        checksum += patterns[i % packed.count];
+    }
+    printf("CheckGuessBatch<%d>  %8.2f ns/answer\n", L, SecondsSince(start) * 1e9 / (batches * packed.count));
+    return checksum;
+}
+
+// Time the scoring and dictionary paths on their own
+static void RunMicroBenchmarks(const BenchWords& words, uint32_t seed) {
+    std::mt19937 random(seed);
+    const WordPlanes& answers = words.game.answers;
+    const size_t guessCount = words.solver.guessCount;
+
+    // Random guess/answer pairs, picked up front so only CheckGuess is timed
+    const size_t pairCount = 4096;
+    std::vector<std::string> pairGuesses(pairCount);
+    std::vector<std::string> pairAnswers(pairCount);
+    for (size_t i = 0; i < pairCount; i++) {
+        pairGuesses[i].assign(words.solver.guesses + random() % guessCount * WORD_LENGTH, WORD_LENGTH);
+        size_t answer = random() % answers.count;
+        pairAnswers[i].assign(WORD_LENGTH, ' ');
+        for (int j = 0; j < WORD_LENGTH; j++) pairAnswers[i][j] = (char)answers.letters[j * answers.stride + answer];
+    }
+
+    const size_t calls = 20000000;
+    unsigned checksum = 0;  // Keeps the compiler from dropping the work
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < calls; i++) {
+        checksum += CheckGuess<WORD_LENGTH>(pairGuesses[i % pairCount].c_str(), pairAnswers[i % pairCount].c_str());
+    }
+    printf("CheckGuess          %8.2f ns/call\n", SecondsSince(start) * 1e9 / calls);
+
+    std::vector<Pattern<WORD_LENGTH>> patterns(answers.count);
+    const size_t batches = std::max<size_t>(1, calls / answers.count);
+    start = Clock::now();
+    for (size_t i = 0; i < batches; i++) {
+        CheckGuessBatch<WORD_LENGTH>(pairGuesses[i % pairCount].c_str(), answers, patterns.data());
+        checksum += patterns[i % answers.count];
+    }
+    printf("CheckGuessBatch     %8.2f ns/answer (%s)\n", SecondsSince(start) * 1e9 / (batches * answers.count), ScoringKernelName());
+
+    if (words.game.dictionary != nullptr) {
+        // Half allowed guesses, half random letters (mostly not words)
+        for (size_t i = 0; i < pairCount; i += 2) {
+            for (int j = 0; j < WORD_LENGTH; j++) pairAnswers[i][j] = (char)('A' + random() % 26);
+        }
+        start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            checksum += words.game.dictionary->Contains(pairAnswers[i % pairCount]);
+        }
+        printf("Dictionary lookup   %8.2f ns/call\n", SecondsSince(start) * 1e9 / calls);
+    }
+
+    // Adversarial mode: every guess re-partitions the remaining answers, so time the slowest guess too
+    AbsurdleCore<WORD_LENGTH> absurdle(words.game);
+    const size_t absurdleGames = 2000;
+    size_t absurdleGuesses = 0;
+    double slowestGuess = 0.0;
+    const size_t allocationsBefore = AllocationCount();
+    start = Clock::now();
+    for (size_t g = 0; g < absurdleGames; g++) {
+        absurdle.NewGame();
+        while (!absurdle.IsOver()) {
+            const Clock::time_point guessStart = Clock::now();
+            absurdle.Submit(words.solver.guesses + random() % guessCount * WORD_LENGTH);
+            slowestGuess = std::max(slowestGuess, SecondsSince(guessStart));
+            absurdleGuesses++;
+        }
+        checksum += (unsigned)absurdle.RemainingCount();
+    }
+    printf("Absurdle game       %8.2f us/game, %.2f us/guess, slowest guess %.2f us, %zu allocations\n", SecondsSince(start) * 1e6 / absurdleGames,
+        SecondsSince(start) * 1e6 / absurdleGuesses, slowestGuess * 1e6, AllocationCount() - allocationsBefore);
+
+    // The kernels of the other word lengths, on random words
+    checksum += TimeBatchLength<4>(random) + TimeBatchLength<6>(random) + TimeBatchLength<7>(random) + TimeBatchLength<8>(random);
+    printf("(checksum %u)\n\n", checksum);
+}
+
+// Fill a statistics store with `games` games of `games / 10` players, then time what the game does
+// with it: opening it at startup, recording a game and looking up a player and the leaderboard
+// Leave the statistics files the way a crash would, then check that reopening them counts every
+// game once: a cut-off last record, a damaged record, and a compaction stopped on either side of
+// the rename of the new summary
+static bool CheckStatsRecovery() {
+    const std::string basePath = "bench-recovery";
+    const std::string logPath = basePath + ".log";
+    const std::string summaryPath = basePath + ".summary";
+    auto removeFiles = [&]() {
+        for (const std::string& path : { logPath, summaryPath, logPath + ".tmp", summaryPath + ".tmp" }) std::remove(path.c_str());
+    };
+    auto readFile = [](const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    };
+    auto writeFile = [](const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(bytes.data(), (std::streamsize)bytes.size());
+    };
+    removeFiles();
+
+    StatsStore store;
+    store.SetDurable(false);
+    GameResult result;
+    result.player = "recovery";
+    result.won = true;
+    result.guesses = 3;
+    result.score = 100;
+    std::string error;
+    bool ok = store.Open(basePath, error);
+    auto record = [&](size_t games) {
+        for (size_t g = 0; ok && g < games; g++) ok = store.Record(result, error);
+    };
+    // Reopen the store and check that it holds `expected` games after `crash`
+    auto expectGames = [&](uint64_t expected, const char* crash) {
+        if (!ok) return;
+        store.Close();
+        PlayerStats stats = {};
+        ok = store.Open(basePath, error);
+        if (ok && (store.TotalGames() != expected || !store.Find(result.player, stats) || stats.games != expected)) {
+            error = std::string("After ") + crash + " it has " + std::to_string(store.TotalGames()) + " games, not " + std::to_string(expected);
+            ok = false;
+        }
+    };
+
+    // A record cut off in the middle: dropped, and the log is cut back so new records follow the last good one
+    record(10);
+    store.Close();
+    std::vector<char> log = readFile(logPath);
+    log.insert(log.end(), sizeof(StatsRecord) / 2, 'X');
+    writeFile(logPath, log);
+    expectGames(10, "a cut-off record");
+    record(1);
+    expectGames(11, "appending to a repaired log");
+
+    // A record with a wrong checksum: it and everything after it are dropped
+    store.Close();
+    log = readFile(logPath);
+    if (log.size() >= sizeof(StatsLogHeader) + 2 * sizeof(StatsRecord)) log[log.size() - 2 * sizeof(StatsRecord) + offsetof(StatsRecord, score)] ^= 1;
+    writeFile(logPath, log);
+    expectGames(9, "a damaged record");
+
+    // Compaction stopped before the rename: the old summary and log are kept, the temporary file is ignored
+    writeFile(summaryPath + ".tmp", std::vector<char>(sizeof(StatsSummaryHeader) / 2, 'X'));
+    expectGames(9, "a compaction cut off before its rename");
+
+    // Compaction stopped after the rename, before the new log was started: the old log is already in the summary
+    store.Close();
+    log = readFile(logPath);
+    ok = ok && store.Open(basePath, error) && store.Compact(error);
+    store.Close();
+    writeFile(logPath, log);
+    expectGames(9, "a compaction cut off after its rename");
+    record(5);
+    expectGames(14, "appending after an interrupted compaction");
+
+    store.Close();
+    removeFiles();
+    if (!ok) {
+        fprintf(stderr, "Stats self-check FAILED: %s\n", error.c_str());
+        return false;
+    }
+    printf("Stats self-check: cut-off and damaged records and interrupted compactions recovered\n\n");
+    return true;
+}
+
+static bool RunStatsBenchmark(size_t games, uint32_t seed) {
+    const std::string basePath = "bench-stats";
+    std::remove((basePath + ".log").c_str());
+    std::remove((basePath + ".summary").c_str());
+    std::mt19937 random(seed);
+    const size_t playerCount = std::max<size_t>(games / 10, 1);
+    std::string error;
+
+    StatsStore store;
+    if (!store.Open(basePath, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    store.SetDurable(false);  // Measure the store, not the disk
+    GameResult result;
+    Clock::time_point start = Clock::now();
+    for (size_t g = 0; g < games; g++) {
+        result.player = "player" + std::to_string(random() % playerCount);
+        result.won = random() % 4 != 0;
+        result.guesses = 1 + (int)(random() % 6);
+        result.score = result.won ? 100 : 0;
+        if (!store.Record(result, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return false;
+        }
+    }
+    printf("Stats record        %8.2f us/game (%zu games, %zu players, compactions included)\n", SecondsSince(start) * 1e6 / games, games, store.PlayerCount());
+    store.Close();
+
+    // Startup: map the summary and replay the log tail written since the last compaction
+    start = Clock::now();
+    if (!store.Open(basePath, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    printf("Stats open          %8.2f us (%llu games)\n", SecondsSince(start) * 1e6, (unsigned long long)store.TotalGames());
+
+    // Queries with a log tail, as in a running game
+    store.SetDurable(true);
+    start = Clock::now();
+    const size_t recorded = 1000;
+    for (size_t g = 0; g < recorded; g++) {
+        result.player = "player" + std::to_string(random() % playerCount);
+        store.Record(result, error);
+    }
+    printf("Stats durable write %8.2f us/game\n", SecondsSince(start) * 1e6 / recorded);
+
+    PlayerStats stats;
+    size_t found = 0;
+    const size_t lookups = 100000;
+    start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) found += store.Find("player" + std::to_string(random() % playerCount), stats);
+    printf("Stats find          %8.2f us/player (%zu found)\n", SecondsSince(start) * 1e6 / lookups, found);
+
+    std::vector<PlayerStats> top;
+    const size_t boards = 1000;
+    start = Clock::now();
+    for (size_t i = 0; i < boards; i++) store.TopPlayers(10, top);
+    printf("Stats top 10        %8.2f us (leader: %s, %llu points)\n\n", SecondsSince(start) * 1e6 / boards, top.empty() ? "-" : top[0].name,
+        top.empty() ? 0ull : (unsigned long long)top[0].totalScore);
+
+    store.Close();
+    std::remove((basePath + ".log").c_str());
+    std::remove((basePath + ".summary").c_str());
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dictionaryPath;
+    std::string strategyName = "all";
+    size_t games = 0;  // 0 = a default that suits each strategy
+    uint32_t seed = 12345;
+    size_t statsGames = 0;  // 0 = skip the statistics store
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--dict") == 0) dictionaryPath = argv[i + 1];
+        else if (strcmp(argv[i], "--strategy") == 0) strategyName = argv[i + 1];
+        else if (strcmp(argv[i], "--games") == 0) games = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--seed") == 0) seed = (uint32_t)strtoul(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--stats") == 0) statsGames = strtoull(argv[i + 1], nullptr, 10);
+        else {
+            fprintf(stderr, "Usage: %s [--dict words5.cdict] [--strategy random|greedy|solver|all] [--games N] [--seed S] [--stats N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Use the dictionary if one was given, otherwise the built-in word list
+    ToolWords toolWords;
+    std::string error;
+    if (!toolWords.Load(dictionaryPath, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    BenchWords words;
+    words.game = toolWords.Game();
+    words.solver.answers = toolWords.Game().answers;
+    words.solver.guesses = toolWords.Guesses();
+    words.solver.guessCount = toolWords.GuessCount();
+
+    printf("Words: %zu answers, %zu guesses (%s)\n\n", words.game.answers.count, words.solver.guessCount,
+        dictionaryPath.empty() ? "built-in list" : dictionaryPath.c_str());
+    if (!CheckKernels(seed)) return 1;  // Timings of a wrong kernel mean nothing
+    if (!CheckDictionaryValidation()) return 1;
+    if (!CheckStatsRecovery()) return 1;
+    RunMicroBenchmarks(words, seed);
+    if (statsGames > 0 && !RunStatsBenchmark(statsGames, seed)) return 1;
+
+    printf("%-8s %10s %12s %12s %6s", "strategy", "games", "games/sec", "allocs/game", "avg");
+    for (int i = 1; i <= ClassicGame::GUESSES; i++) printf(" %7d", i);
+    printf(" %7s\n", "lost");
+
+    const bool all = strategyName == "all";
+    if (!all && strategyName != "random" && strategyName != "greedy" && strategyName != "solver") {
+        fprintf(stderr, "Unknown strategy: %s\n", strategyName.c_str());
+        return 1;
+    }
+    if (all || strategyName == "random") {
+        RandomStrategy strategy(words, seed + 1);  // Different seed than the answers, or it would guess them
+        RunStrategy(strategy, words, games ? games : 1000000, seed);
+    }
+    if (all || strategyName == "greedy") {
+        GreedyStrategy strategy(words, seed + 1);
+        RunStrategy(strategy, words, games ? games : 1000000, seed);
+    }
+    if (all || strategyName == "solver") {
+        SolverStrategy strategy(words);
+        RunStrategy(strategy, words, games ? games : 200, seed);
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "GameCore.h"  // For GameWords, GuessResult and the shared GameInput
+#include "Scoring.h"   // For CheckGuessBatch and feedback patterns
+#include "Profiler.h"  // For timing the partitioning
+#include <cstdint>     // For uint8_t and uint32_t
+#include <cstring>     // For memcpy
+#include <vector>      // For the answer set buffers
+
+// Adversarial game ("Absurdle"): no answer is picked up front. After every guess the game keeps
+// the largest group of the remaining answers that share a feedback pattern, so the player is
+// always shown the least helpful feedback. The feedback history stays consistent because every
+// answer left gives exactly the feedbacks shown so far.
+//
+// The remaining answers are kept as a compact list of indices into the answer list plus their own
+// word planes. A guess scores only that list (one CheckGuessBatch call), counts the patterns and
+// compacts the winning bucket in place, so the work shrinks with the answer set. All buffers are
+// sized when the game is created; starting a game or submitting a guess never allocates.
+//
+// Typing, the history and the score come from GameInput like in GameCore<L, 1>, so the raylib loop
+// and the benchmark can play both the same way.
+template <int L>
+class AbsurdleCore : public GameInput<AbsurdleCore<L>, L, 1, 8> {  // 8 guesses: more than the classic game, the answer keeps dodging
+    typedef GameInput<AbsurdleCore<L>, L, 1, 8> Input;
+
+public:
+    static const bool ADVERSARIAL = true;
+    typedef typename Input::PatternType PatternType;
+    using Input::Submit;  // Submit(const char*)
+
+    explicit AbsurdleCore(const GameWords& words)
+        : Input(words),
+          survivors(words.answers.count),
+          letters(words.answers.stride * L),
+          patterns(words.answers.stride),
+          patternCounts(PatternTraits<L>::COUNT, 0) {
+        NewGame();
+    }
+
+    // Make every answer possible again and clear the board (the score is kept)
+    void NewGame() {
+        for (size_t w = 0; w < survivors.size(); w++) survivors[w] = (uint32_t)w;
+        memcpy(letters.data(), words.answers.letters, letters.size());  // Start from the full answer planes
+        remaining.letters = letters.data();
+        remaining.count = words.answers.count;
+        remaining.stride = words.answers.stride;
+        solvedAt = 0;
+        this->ClearInput();
+    }
+
+    // Score the current guess against the remaining answers and keep the largest bucket (ENTER)
+    GuessResult Submit() {
+        const GuessResult check = this->CheckCurrentGuess();
+        if (check != GuessResult::Accepted) return check;
+
+        const PatternType feedback = Partition(currentGuess);
+        this->AddGuess(&feedback);  // Store the feedback of the bucket that was kept
+
+        if (feedback == PatternTraits<L>::SOLVED) {
+            solvedAt = (uint8_t)guessCount;  // Only the guess itself was left
+            score += 100;
+            gameOver = true;
+        }
+        else if (guessCount >= Input::GUESSES) {
+            gameOver = true;  // End the game when the guesses run out
+        }
+        return GuessResult::Accepted;
+    }
+
+    // One of the answers that is still possible (the answer once the game is won)
+    const char* Answer(int) const {
+        for (int i = 0; i < L; i++) answer[i] = (char)remaining.letters[i * remaining.stride];
+        answer[L] = '\0';
+        return answer;
+    }
+
+    size_t RemainingCount() const { return remaining.count; }           // Answers that are still possible
+    uint32_t Remaining(size_t i) const { return survivors[i]; }          // Index in the answer list of a possible answer
+    int SolvedAt(int) const { return solvedAt; }  // Number of guesses that solved the game, 0 if unsolved
+    bool IsWon() const { return solvedAt != 0; }
+
+private:
+    using Input::words;
+    using Input::currentGuess;
+    using Input::guessCount;
+    using Input::score;
+    using Input::gameOver;
+
+    // Split the remaining answers by the feedback they give for `guess`, keep the largest bucket
+    // and return its pattern. Ties go to the lowest pattern, so the solved pattern (the highest)
+    // is only chosen when the guess is the last answer left.
+    PatternType Partition(const char* guess) {
+        PROFILE_SCOPE("CheckGuess");
+        PROFILE_COUNT("answers scored", remaining.count);
+        CheckGuessBatch<L>(guess, remaining, patterns.data());
+
+        // Find the largest bucket while counting (counts only grow, so the last leader wins)
+        PatternType best = 0;
+        uint32_t bestCount = 0;
+        for (size_t w = 0; w < remaining.count; w++) {
+            const PatternType pattern = patterns[w];
+            const uint32_t count = ++patternCounts[pattern];
+            if (count > bestCount || (count == bestCount && pattern < best)) {
+                best = pattern;
+                bestCount = count;
+            }
+        }
+
+        // Move the bucket to the front of the index list and the planes, keeping its order
+        size_t kept = 0;
+        for (size_t w = 0; w < remaining.count; w++) {
+            patternCounts[patterns[w]] = 0;  // Clear only the counts that were used
+            if (patterns[w] != best) continue;
+            survivors[kept] = survivors[w];
+            for (int i = 0; i < L; i++) letters[i * remaining.stride + kept] = letters[i * remaining.stride + w];
+            kept++;
+        }
+        remaining.count = kept;  // Letters after `kept` are stale; CheckGuessBatch ignores them
+        return best;
+    }
+
+    std::vector<uint32_t> survivors;      // Indices of the possible answers in the answer list, compacted
+    std::vector<uint8_t> letters;         // Word planes of the possible answers (same order as survivors)
+    std::vector<PatternType> patterns;    // Feedback of the current guess for each possible answer
+    std::vector<uint32_t> patternCounts;  // Answers per feedback pattern, all zero between guesses
+    WordPlanes remaining;                 // View of the first remaining.count words of `letters`
+    mutable char answer[L + 1];           // Buffer for Answer()
+    uint8_t solvedAt = 0;                 // Guess number that solved the game (0 = unsolved)
+};
@@ -0,0 +1,37 @@
+#include "AllocCounter.h"
+#include <atomic>   // For the counter
+#include <cstdlib>  // For malloc and free
+#include <new>      // For std::bad_alloc
+
+static std::atomic<size_t> allocationCount{ 0 };
+
+size_t AllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* memory = malloc(size ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <cstddef>  // For size_t
+
+// Counts every heap allocation of the program, so the benchmark and the server can show that their
+// hot loops never allocate. Linking AllocCounter.cpp replaces the global operator new and delete;
+// only those tools link it, the game does not.
+size_t AllocationCount();  // Allocations since the program started
@@ -0,0 +1,296 @@
+#include "Dictionary.h"
+#include <algorithm>      // For std::sort and std::find
+#include <cstring>        // For memcpy
+#include <fstream>        // For reading word lists and writing the dictionary
+#include <unordered_set>  // For removing duplicate words
+#include <vector>         // For building the sections in memory
+
+static const uint64_t SECTION_ALIGNMENT = 64;  // Sections start on cache line boundaries
+
+// Scramble the bits of a 64-bit value (splitmix64 finalizer)
+static uint64_t MixBits(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+// Perfect hash: a word picks a bucket, and the bucket's seed picks the slot
+static uint32_t HashBucket(uint64_t code, uint32_t bucketCount) {
+    return (uint32_t)(MixBits(code) % bucketCount);
+}
+
+static uint32_t HashSlot(uint64_t code, uint32_t seed, uint32_t slotCount) {
+    return (uint32_t)(MixBits(code ^ (seed * 0x9E3779B97F4A7C15ull)) % slotCount);
+}
+
+// Pack a word into 6 bits per letter, returns 0 if it contains a byte that is not a letter
+static uint64_t EncodeWord(const uint8_t* letterCodes, const char* word, size_t length) {
+    uint64_t code = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint64_t letter = letterCodes[(uint8_t)word[i]];
+        if (letter == 0) return 0;
+        code |= letter << (6 * i);
+    }
+    return code;
+}
+
+static uint64_t AlignUp(uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Check that `size` bytes at `offset` lie inside the file, without overflowing on huge offsets
+static bool SectionFits(uint64_t offset, uint64_t size, uint64_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+bool Dictionary::Open(const std::string& path, std::string& error) {
+    Close();
+    if (!file.Open(path)) {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    const uint8_t* data = file.Data();
+    const DictionaryHeader* candidate = reinterpret_cast<const DictionaryHeader*>(data);
+    if (file.Size() < sizeof(DictionaryHeader) || candidate->magic != DICTIONARY_MAGIC) {
+        error = path + " is not a dictionary file";
+        file.Close();
+        return false;
+    }
+    if (candidate->version != DICTIONARY_VERSION) {
+        error = path + " was built by another version, build it again with --build-dict";
+        file.Close();
+        return false;
+    }
+
+    // Make sure every section lies inside the file before trusting any offsets. The sizes cannot
+    // overflow (counts are 32-bit and the length is small); the batch kernels read whole blocks,
+    // so the planes must be padded to a whole number of them; the hash divides by the slot count.
+    const uint64_t length = candidate->wordLength;
+    const uint64_t size = file.Size();
+    bool valid = length > 0 && length <= MAX_DICTIONARY_WORD_LENGTH
+        && candidate->answerCount > 0 && candidate->answerStride >= candidate->answerCount
+        && candidate->answerStride % WORD_BLOCK == 0
+        && candidate->bucketCount > 0 && candidate->slotCount > 0 && candidate->slotCount >= candidate->guessCount
+        && SectionFits(candidate->answerOffset, length * candidate->answerStride, size)
+        && SectionFits(candidate->guessOffset, length * candidate->guessCount, size)
+        && SectionFits(candidate->seedOffset, sizeof(uint32_t) * candidate->bucketCount, size)
+        && SectionFits(candidate->slotOffset, sizeof(uint64_t) * candidate->slotCount, size)
+        && candidate->seedOffset % sizeof(uint32_t) == 0 && candidate->slotOffset % sizeof(uint64_t) == 0;
+    if (!valid) {
+        error = path + " is damaged";
+        file.Close();
+        return false;
+    }
+
+    header = candidate;
+    answers = data + header->answerOffset;
+    guesses = reinterpret_cast<const char*>(data + header->guessOffset);
+    seeds = reinterpret_cast<const uint32_t*>(data + header->seedOffset);
+    slots = reinterpret_cast<const uint64_t*>(data + header->slotOffset);
+    return true;
+}
+
+bool Dictionary::Open(const std::string& path, int wordLength, std::string& error) {
+    if (!Open(path, error)) return false;
+    if (WordLength() != wordLength) {
+        error = path + " has " + std::to_string(WordLength()) + "-letter words, not " + std::to_string(wordLength);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void Dictionary::Close() {
+    file.Close();
+    header = nullptr;
+    answers = nullptr;
+    guesses = nullptr;
+    seeds = nullptr;
+    slots = nullptr;
+}
+
+WordPlanes Dictionary::Answers() const {
+    WordPlanes view;
+    view.letters = answers;
+    view.count = header->answerCount;
+    view.stride = header->answerStride;
+    return view;
+}
+
+std::string Dictionary::Answer(size_t index) const {
+    std::string word(header->wordLength, ' ');
+    for (uint32_t i = 0; i < header->wordLength; i++) {
+        word[i] = (char)answers[i * header->answerStride + index];  // Gather the letters from each plane
+    }
+    return word;
+}
+
+const char* Dictionary::Guess(size_t index) const {
+    return guesses + index * header->wordLength;
+}
+
+bool Dictionary::Contains(const char* word, size_t length) const {
+    if (length != header->wordLength) return false;
+    uint64_t code = EncodeWord(header->letterCodes, word, length);
+    if (code == 0) return false;  // Contains a character that no word uses
+
+    uint32_t seed = seeds[HashBucket(code, header->bucketCount)];
+    return slots[HashSlot(code, seed, header->slotCount)] == code;
+}
+
+// Read one word per line, trimming spaces and upper-casing a-z
+static bool ReadWordList(const std::string& path, std::vector<std::string>& words, std::string& error) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(input, line)) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        size_t end = line.find_last_not_of(" \t\r");
+        if (begin == std::string::npos) continue;  // Skip empty lines
+
+        std::string word = line.substr(begin, end - begin + 1);
+        for (char& c : word) {
+            if (c >= 'a' && c <= 'z') c -= 32;
+        }
+        words.push_back(word);
+    }
+    return true;
+}
+
+bool BuildDictionary(const std::string& answersPath, const std::string& guessesPath, const std::string& outputPath, std::string& error) {
+    std::vector<std::string> answerLines;
+    std::vector<std::string> guessLines;
+    if (!ReadWordList(answersPath, answerLines, error)) return false;
+    if (!guessesPath.empty() && !ReadWordList(guessesPath, guessLines, error)) return false;
+    if (answerLines.empty()) {
+        error = answersPath + " has no words";
+        return false;
+    }
+
+    const size_t wordLength = answerLines[0].size();
+    if (wordLength > MAX_DICTIONARY_WORD_LENGTH) {
+        error = "Words can have at most " + std::to_string(MAX_DICTIONARY_WORD_LENGTH) + " letters";
+        return false;
+    }
+
+    // Keep each word once, answers first so they are allowed as guesses too
+    std::vector<std::string> answerWords;
+    std::vector<std::string> guessWords;
+    std::unordered_set<std::string> seenAnswers;
+    std::unordered_set<std::string> seenGuesses;
+    for (const std::string& word : answerLines) {
+        if (word.size() != wordLength) continue;
+        if (seenAnswers.insert(word).second) answerWords.push_back(word);
+        if (seenGuesses.insert(word).second) guessWords.push_back(word);
+    }
+    for (const std::string& word : guessLines) {
+        if (word.size() == wordLength && seenGuesses.insert(word).second) guessWords.push_back(word);
+    }
+
+    // Give every letter byte that appears a code, in byte order so the output is reproducible
+    DictionaryHeader header = {};
+    bool used[256] = { false };
+    for (const std::string& word : guessWords) {
+        for (char c : word) used[(uint8_t)c] = true;
+    }
+    int letterCount = 0;
+    for (int c = 0; c < 256; c++) {
+        if (!used[c]) continue;
+        if (++letterCount > MAX_DICTIONARY_LETTERS) {
+            error = "Words use more than " + std::to_string(MAX_DICTIONARY_LETTERS) + " different letters";
+            return false;
+        }
+        header.letterCodes[c] = (uint8_t)letterCount;
+    }
+
+    std::vector<uint64_t> codes;
+    codes.reserve(guessWords.size());
+    for (const std::string& word : guessWords) {
+        codes.push_back(EncodeWord(header.letterCodes, word.c_str(), wordLength));
+    }
+
+    // Build the perfect hash: place the largest buckets first, trying seeds until all of a
+    // bucket's words land in distinct free slots
+    const uint32_t guessCount = (uint32_t)guessWords.size();
+    const uint32_t bucketCount = guessCount / 4 + 1;
+    const uint32_t slotCount = guessCount + guessCount / 4 + 1;
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+    for (uint32_t i = 0; i < guessCount; i++) {
+        buckets[HashBucket(codes[i], bucketCount)].push_back(i);
+    }
+    std::vector<uint32_t> order(bucketCount);
+    for (uint32_t b = 0; b < bucketCount; b++) order[b] = b;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<uint32_t> seeds(bucketCount, 0);
+    std::vector<uint64_t> slots(slotCount, 0);
+    std::vector<uint32_t> placed;
+    for (uint32_t b : order) {
+        if (buckets[b].empty()) break;
+        bool found = false;
+        for (uint32_t seed = 1; seed != 0 && !found; seed++) {
+            placed.clear();
+            found = true;
+            for (uint32_t word : buckets[b]) {
+                uint32_t slot = HashSlot(codes[word], seed, slotCount);
+                if (slots[slot] != 0 || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                    found = false;
+                    break;
+                }
+                placed.push_back(slot);
+            }
+            if (found) {
+                seeds[b] = seed;
+                for (size_t i = 0; i < placed.size(); i++) slots[placed[i]] = codes[buckets[b][i]];
+            }
+        }
+        if (!found) {
+            error = "Could not build the word index";
+            return false;
+        }
+    }
+
+    // Lay out the sections
+    header.magic = DICTIONARY_MAGIC;
+    header.version = DICTIONARY_VERSION;
+    header.wordLength = (uint32_t)wordLength;
+    header.answerCount = (uint32_t)answerWords.size();
+    header.answerStride = (uint32_t)PlaneStride(answerWords.size());
+    header.guessCount = guessCount;
+    header.bucketCount = bucketCount;
+    header.slotCount = slotCount;
+    header.answerOffset = AlignUp(sizeof(DictionaryHeader));
+    header.guessOffset = AlignUp(header.answerOffset + wordLength * header.answerStride);
+    header.seedOffset = AlignUp(header.guessOffset + wordLength * guessCount);
+    header.slotOffset = AlignUp(header.seedOffset + sizeof(uint32_t) * bucketCount);
+    const uint64_t fileSize = header.slotOffset + sizeof(uint64_t) * slotCount;
+
+    std::vector<uint8_t> image(fileSize, 0);
+    memcpy(image.data(), &header, sizeof(header));
+    for (size_t i = 0; i < wordLength; i++) {
+        for (size_t w = 0; w < answerWords.size(); w++) {  // Answers are stored position by position
+            image[header.answerOffset + i * header.answerStride + w] = (uint8_t)answerWords[w][i];
+        }
+    }
+    for (uint32_t i = 0; i < guessCount; i++) {
+        memcpy(&image[header.guessOffset + (uint64_t)i * wordLength], guessWords[i].data(), wordLength);
+    }
+    memcpy(&image[header.seedOffset], seeds.data(), sizeof(uint32_t) * bucketCount);
+    memcpy(&image[header.slotOffset], slots.data(), sizeof(uint64_t) * slotCount);
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(image.data()), (std::streamsize)image.size());
+    if (!output) {
+        error = "Cannot write " + outputPath;
+        return false;
+    }
+    return true;
+}
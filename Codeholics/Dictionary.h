@@ -0,0 +1,73 @@
+#pragma once
+#include "MappedFile.h"  // The dictionary file is memory-mapped, never parsed
+#include "Scoring.h"     // For WordPlanes
+#include <cstddef>       // For size_t
+#include <cstdint>       // For fixed-width integer types
+#include <string>        // For paths and error messages
+
+// On-disk dictionary (.cdict). Every section is stored exactly as the game uses it, so opening
+// a dictionary only maps the file and checks the header. All numbers are little-endian.
+//
+//   DictionaryHeader
+//   answer planes     wordLength planes of answerStride bytes (see WordPlanes)
+//   guess words       guessCount words of wordLength bytes, every allowed guess (answers included)
+//   bucket seeds      bucketCount uint32 values for the perfect hash
+//   slots             slotCount uint64 word codes (0 = empty slot)
+//
+// Letters are single bytes, so any language with a single-byte code page and at most
+// 63 letters (Latin, Polish in Windows-1250, Russian or Ukrainian in Windows-1251, ...) can be stored.
+
+const uint32_t DICTIONARY_MAGIC = 0x54434443;  // "CDCT"
+const uint32_t DICTIONARY_VERSION = 2;         // Version 1 had 5-bit letter codes
+const int MAX_DICTIONARY_LETTERS = 63;         // Letter codes are 6 bits, 0 means "not a letter"
+const int MAX_DICTIONARY_WORD_LENGTH = 10;     // 10 letters * 6 bits fit in a 64-bit word code
+
+struct DictionaryHeader {
+    uint32_t magic;            // DICTIONARY_MAGIC
+    uint32_t version;          // DICTIONARY_VERSION
+    uint32_t wordLength;       // Letters per word
+    uint32_t answerCount;      // Words that can be picked as the secret word
+    uint32_t answerStride;     // Bytes per answer plane
+    uint32_t guessCount;       // Words accepted as guesses
+    uint32_t bucketCount;      // Perfect hash buckets
+    uint32_t slotCount;        // Perfect hash slots
+    uint64_t answerOffset;     // File offsets of each section
+    uint64_t guessOffset;
+    uint64_t seedOffset;
+    uint64_t slotOffset;
+    uint8_t letterCodes[256];  // Code (1..63) of each letter byte, 0 for bytes that are not letters
+};
+
+// A dictionary mapped from disk
+class Dictionary {
+public:
+    bool Open(const std::string& path, std::string& error);  // Map and validate a .cdict file
+    bool Open(const std::string& path, int wordLength, std::string& error);  // Same, and the words must have `wordLength` letters
+    void Close();
+
+    bool IsLoaded() const { return header != nullptr; }
+    int WordLength() const { return (int)header->wordLength; }
+    size_t AnswerCount() const { return header->answerCount; }
+    size_t GuessCount() const { return header->guessCount; }
+
+    WordPlanes Answers() const;             // Answers ready for CheckGuessBatch
+    std::string Answer(size_t index) const; // One answer as a string
+    const char* Guess(size_t index) const;  // One allowed guess (WordLength() bytes, not null-terminated)
+
+    // Check in constant time whether a word is an allowed guess
+    bool Contains(const char* word, size_t length) const;
+    bool Contains(const std::string& word) const { return Contains(word.c_str(), word.size()); }
+
+private:
+    MappedFile file;
+    const DictionaryHeader* header = nullptr;
+    const uint8_t* answers = nullptr;
+    const char* guesses = nullptr;
+    const uint32_t* seeds = nullptr;
+    const uint64_t* slots = nullptr;
+};
+
+// Convert word-per-line text files into a .cdict file. Lines are trimmed and a-z is upper-cased;
+// lines of a different length than the first answer are skipped. Answers are always allowed as
+// guesses, so `guessesPath` may be empty.
+bool BuildDictionary(const std::string& answersPath, const std::string& guessesPath, const std::string& outputPath, std::string& error);
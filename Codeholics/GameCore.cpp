@@ -0,0 +1,13 @@
+#include "GameCore.h"
+
+const std::vector<std::string>& BuiltInWords(int length) {
+    static const std::vector<std::string> wordLists[MAX_WORD_LENGTH + 1] = {
+        {}, {}, {}, {},
+        { "TREE", "BOOK", "FISH", "LAMP", "MOON", "RAIN", "SNOW", "STAR", "WIND", "GOLD", "BIRD", "CAKE", "DOOR", "FIRE", "HAND", "SHIP" },
+        { "CRANE", "PLANE", "BRAVE", "GRAPE", "SHINE", "BLEND", "DRIVE", "CHIME", "PANTS", "STONE", "STOVE", "PLAIN", "STAIN", "PHOTO", "PHONE", "MOUSE" },
+        { "PLANET", "GARDEN", "SILVER", "BRIDGE", "CASTLE", "FOREST", "ORANGE", "PENCIL", "ROCKET", "SUMMER", "WINTER", "BUTTER", "CIRCLE", "DRAGON", "FLOWER", "MARKET" },
+        { "BALANCE", "CAPTAIN", "DIAMOND", "EMPEROR", "FREEDOM", "GALLERY", "HARVEST", "JOURNEY", "KITCHEN", "LIBRARY", "MORNING", "NETWORK", "PICTURE", "RAINBOW", "SUNRISE", "TEACHER" },
+        { "ALPHABET", "BIRTHDAY", "CHAMPION", "DINOSAUR", "ELEPHANT", "FOOTBALL", "HOMEWORK", "KEYBOARD", "LANGUAGE", "MOUNTAIN", "NOTEBOOK", "PAINTING", "QUESTION", "SANDWICH", "TREASURE", "UMBRELLA" }
+    };
+    return wordLists[length];
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include "Dictionary.h"  // Guesses are checked against the dictionary
+#include "Profiler.h"    // For timing the scoring
+#include "Scoring.h"     // For CheckGuess and feedback patterns
+#include <cstdint>       // For uint8_t and uint32_t
+#include <cstring>       // For memcpy and memset
+#include <random>        // For picking answers
+#include <string>        // For words
+#include <vector>        // For the hint history
+
+// Words a game is played with. Both must stay alive as long as the games using them.
+struct GameWords {
+    WordPlanes answers;                      // Secret words are picked from these
+    const Dictionary* dictionary = nullptr;  // Guesses must be in here (nullptr accepts any guess)
+};
+
+// What happened when a guess was submitted
+enum class GuessResult {
+    Accepted,       // The guess was scored and added to the board
+    Incomplete,     // The guess does not have enough letters yet
+    NotInWordList,  // The guess is not in the dictionary
+    GameOver        // The game has already ended
+};
+
+// Built-in word list for a word length, used when there is no dictionary file
+const std::vector<std::string>& BuiltInWords(int length);
+
+// Board counts the game can be played with
+const int BOARD_COUNTS[] = { 1, 2, 4, 8 };
+const int BOARD_COUNT_OPTIONS = 4;
+const int MAX_BOARDS = 8;
+
+// Input and history shared by every game variant: the guess being typed, the guesses made so far
+// with their feedback on each of the B boards, the score and whether the game is over. `Game`
+// is the variant deriving from it (CRTP). It implements Submit(), which checks the current guess
+// with CheckCurrentGuess(), scores it by its own rules and stores it with AddGuess().
+template <class Game, int L, int B, int G>
+class GameInput {
+public:
+    static const int LENGTH = L;   // Letters per word
+    static const int BOARDS = B;   // Secret words played at once
+    static const int GUESSES = G;  // Guesses allowed
+    typedef Pattern<L> PatternType;
+
+    // Add an upper-case letter to the current guess
+    void TypeLetter(char letter) {
+        if (gameOver || currentLength >= L) return;
+        currentGuess[currentLength++] = letter;
+        currentGuess[currentLength] = '\0';
+        notInWordList = false;  // Hide the warning once the player edits the guess
+    }
+
+    // Remove the last letter of the current guess
+    void Backspace() {
+        if (gameOver || currentLength == 0) return;
+        currentGuess[--currentLength] = '\0';
+        notInWordList = false;
+    }
+
+    // Type a whole L-letter guess and submit it
+    GuessResult Submit(const char* guess) {
+        if (gameOver) return GuessResult::GameOver;
+        memcpy(currentGuess, guess, L);
+        currentGuess[L] = '\0';
+        currentLength = L;
+        return static_cast<Game*>(this)->Submit();
+    }
+
+    // Guess and feedback history of one board, in the form the hint solver takes
+    void History(int board, std::vector<std::string>& historyGuesses, std::vector<PatternType>& historyFeedbacks) const {
+        historyGuesses.clear();
+        historyFeedbacks.clear();
+        for (int g = 0; g < guessCount; g++) {
+            historyGuesses.push_back(guesses[g]);
+            historyFeedbacks.push_back(feedbacks[g][board]);
+        }
+    }
+
+    const char* CurrentGuess() const { return currentGuess; }
+    int CurrentLength() const { return currentLength; }
+    int GuessCount() const { return guessCount; }
+    const char* Guess(int index) const { return guesses[index]; }
+    PatternType Feedback(int index, int board) const { return feedbacks[index][board]; }
+    int Score() const { return score; }
+    bool IsOver() const { return gameOver; }
+    bool IsNotInWordList() const { return notInWordList; }
+    bool ChecksWords() const { return words.dictionary != nullptr; }  // False without a dictionary: every guess is accepted
+
+protected:
+    explicit GameInput(const GameWords& words)
+        : words(words) {}
+
+    // Clear the guesses and the input for a new game (the score is kept)
+    void ClearInput() {
+        guessCount = 0;  // Clear guesses
+        currentLength = 0;  // Reset current guess
+        currentGuess[0] = '\0';
+        gameOver = false;  // Reset game over flag
+        notInWordList = false;
+    }
+
+    // Whether the current guess can be scored: Accepted, or why not
+    GuessResult CheckCurrentGuess() {
+        if (gameOver) return GuessResult::GameOver;
+        if (currentLength != L) return GuessResult::Incomplete;
+        if (words.dictionary != nullptr && !words.dictionary->Contains(currentGuess, L)) {
+            notInWordList = true;  // Reject words that are not in the dictionary
+            return GuessResult::NotInWordList;
+        }
+        return GuessResult::Accepted;
+    }
+
+    // Store the current guess with its feedback on every board and clear the input
+    void AddGuess(const PatternType* boardFeedbacks) {
+        memcpy(guesses[guessCount], currentGuess, L + 1);  // Store the guess
+        for (int b = 0; b < B; b++) feedbacks[guessCount][b] = boardFeedbacks[b];
+        guessCount++;
+        currentLength = 0;  // Reset current guess
+        currentGuess[0] = '\0';
+    }
+
+    GameWords words;
+    char guesses[G][L + 1];                      // Player guesses
+    PatternType feedbacks[G][B];                 // Feedback pattern for each guess on each board
+    char currentGuess[L + 1];                    // The guess being typed
+    int currentLength = 0;
+    int guessCount = 0;
+    int score = 0;                               // Player's score
+    bool gameOver = false;                       // Flag indicating if the game is over
+    bool notInWordList = false;                  // Flag indicating if the last submitted guess was rejected
+};
+
+// The rules of one game without any drawing or input handling, so the game can be played
+// by the raylib loop, simulations and benchmarks alike.
+//
+// Every variant is its own type: L letters per word, B boards (secret words) sharing each typed
+// guess, 5 + B guesses (6 for one board, 7/9/13 for 2/4/8). All state lives in fixed-size arrays,
+// so a game never allocates, and the answers of all boards are kept as one block of word planes
+// so a guess is scored against every board with a single CheckGuessBlock call.
+template <int L, int B>
+class GameCore : public GameInput<GameCore<L, B>, L, B, 5 + B> {
+    typedef GameInput<GameCore<L, B>, L, B, 5 + B> Input;
+
+public:
+    static_assert(B >= 1 && B <= (int)WORD_BLOCK, "Too many boards");
+    static const bool ADVERSARIAL = false; // The answers are picked when the game starts
+    typedef typename Input::PatternType PatternType;
+    using Input::Submit;  // Submit(const char*)
+
+    GameCore(const GameWords& words, uint32_t seed)
+        : Input(words), random(seed) {
+        memset(boardLetters, 0, sizeof(boardLetters));  // Unused lanes stay zero and never match
+        NewGame();
+    }
+
+    // Pick new answers and clear the boards (the score is kept)
+    void NewGame() {
+        std::uniform_int_distribution<size_t> pick(0, words.answers.count - 1);
+        char chosen[B * L];
+        for (int b = 0; b < B; b++) {
+            size_t index = pick(random);  // Select a random answer, different from the other boards if possible
+            for (int tries = 0; tries < 16 && IsPicked(chosen, b, index); tries++) index = pick(random);
+            for (int i = 0; i < L; i++) chosen[b * L + i] = (char)words.answers.letters[i * words.answers.stride + index];
+        }
+        NewGame(chosen);
+    }
+
+    // Start a game with known answers (B words of L letters, back to back)
+    void NewGame(const char* chosen) {
+        for (int b = 0; b < B; b++) {
+            for (int i = 0; i < L; i++) {
+                answers[b][i] = chosen[b * L + i];
+                boardLetters[i][b] = (uint8_t)chosen[b * L + i];
+            }
+            answers[b][L] = '\0';
+            solvedAt[b] = 0;
+        }
+        solvedCount = 0;
+        this->ClearInput();
+    }
+
+    // Score the current guess on every board (ENTER)
+    GuessResult Submit() {
+        const GuessResult check = this->CheckCurrentGuess();
+        if (check != GuessResult::Accepted) return check;
+
+        // Score the guess against all boards at once
+        PROFILE_SCOPE("CheckGuess");
+        PROFILE_COUNT("answers scored", B);
+        PatternType patterns[WORD_BLOCK];
+        WordPlanes boards;
+        boards.letters = &boardLetters[0][0];
+        boards.count = B;
+        boards.stride = WORD_BLOCK;
+        CheckGuessBlock<L>(currentGuess, boards, 0, patterns);
+
+        for (int b = 0; b < B; b++) {
+            if (solvedAt[b] == 0 && patterns[b] == PatternTraits<L>::SOLVED) {
+                solvedAt[b] = (uint8_t)(guessCount + 1);  // This board is done
+                solvedCount++;
+                score += 100;  // Add points for every solved board
+            }
+        }
+        this->AddGuess(patterns);
+
+        // Check if every board is solved
+        if (solvedCount == B || guessCount >= Input::GUESSES) {
+            gameOver = true;  // End the game when all boards are solved or the guesses run out
+        }
+        return GuessResult::Accepted;
+    }
+
+    const char* Answer(int board) const { return answers[board]; }
+    int SolvedAt(int board) const { return solvedAt[board]; }  // Number of guesses that solved the board, 0 if unsolved
+    bool IsWon() const { return solvedCount == B; }
+
+private:
+    using Input::words;
+    using Input::currentGuess;
+    using Input::guessCount;
+    using Input::score;
+    using Input::gameOver;
+
+    // Check if answer `index` is already used by one of the first `boards` boards
+    bool IsPicked(const char* chosen, int boards, size_t index) const {
+        for (int b = 0; b < boards; b++) {
+            bool same = true;
+            for (int i = 0; i < L; i++) same = same && chosen[b * L + i] == (char)words.answers.letters[i * words.answers.stride + index];
+            if (same) return true;
+        }
+        return false;
+    }
+
+    std::minstd_rand random;                     // Picks the answers (small, so thousands of games fit in memory)
+    char answers[B][L + 1];                      // The secret words
+    uint8_t boardLetters[L][WORD_BLOCK];         // The secret words as word planes for CheckGuessBlock
+    uint8_t solvedAt[B];                         // Guess number that solved each board (0 = unsolved)
+    int solvedCount = 0;
+};
+
+// The classic game
+typedef GameCore<WORD_LENGTH, 1> ClassicGame;
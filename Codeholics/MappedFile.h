@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>   // For size_t
+#include <cstdint>   // For uint8_t
+#include <string>    // For file paths
+
+// Read-only memory mapping of a whole file. The operating system pages the data in on demand,
+// so opening even a large file costs almost nothing at startup.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);  // Map the file, returns false if it cannot be opened
+    void Close();                        // Unmap the file (safe to call when nothing is open)
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;  // Start of the mapping
+    size_t size = 0;                // Length of the file in bytes
+#ifdef _WIN32
+    void* fileHandle = nullptr;     // HANDLE of the open file
+    void* mappingHandle = nullptr;  // HANDLE of the file mapping object
+#endif
+};
@@ -0,0 +1,263 @@
+#include "Profiler.h"
+
+#ifdef CODEHOLICS_PROFILE
+#include <algorithm>  // For percentiles
+#include <atomic>     // For the lock-free buffers
+#include <cstdio>     // For snprintf
+#include <cstring>    // For strcmp
+#include <fstream>    // For writing the trace
+#include <mutex>      // For registering counters
+#include <vector>     // For copying events out of the buffers
+
+enum class ProfileEventKind : uint32_t {
+    Scope,    // start .. end
+    Counter,  // end holds the value
+};
+
+// One slot of a ring buffer. The owning thread is the only writer; every field is atomic so other
+// threads can read while it writes (relaxed atomics are plain loads and stores on x86 and ARM).
+struct ProfileEvent {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> start{ 0 };
+    std::atomic<uint64_t> end{ 0 };
+    std::atomic<ProfileEventKind> kind{ ProfileEventKind::Scope };
+};
+
+// The buffer and counters of one thread
+struct ProfileThread {
+    int id = 0;                                    // Thread id in traces
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> written{ 0 };            // Events ever written; the newest is at (written - 1) % size
+    std::atomic<uint64_t> counters[MAX_PROFILE_COUNTERS] = {};
+    ProfileEvent events[PROFILE_EVENTS_PER_THREAD];
+};
+
+// An event copied out of a buffer
+struct ProfileSample {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    ProfileEventKind kind;
+    int thread;
+};
+
+static std::atomic<ProfileThread*> profileThreads[MAX_PROFILE_THREADS] = {};
+static std::atomic<int> profileThreadCount{ 0 };
+static thread_local ProfileThread* currentThread = nullptr;
+static thread_local bool currentThreadFull = false;  // Too many threads, this one is not recorded
+
+static std::mutex counterMutex;  // Only for registering names
+static const char* counterNames[MAX_PROFILE_COUNTERS] = {};
+static std::atomic<int> counterCount{ 0 };
+
+static const uint64_t profileStart = ProfileNow();  // Time 0 of traces
+
+// Frame history, only touched by the thread that marks the frames
+static uint64_t frameStart = 0;
+static double frameTimes[PROFILE_FRAME_HISTORY];      // Work per frame in milliseconds
+static double frameIntervals[PROFILE_FRAME_HISTORY];  // Time between frame starts in milliseconds
+static int frameCount = 0;
+static int intervalCount = 0;                         // Intervals ever stored; they fill frameIntervals in order
+static uint64_t counterTotals[MAX_PROFILE_COUNTERS] = {};   // Sums over every thread at the end of the last frame
+static uint64_t lastFrameCounts[MAX_PROFILE_COUNTERS] = {};
+
+// The calling thread's buffer, created by its first event
+static ProfileThread* CurrentThread() {
+    if (currentThread != nullptr || currentThreadFull) return currentThread;
+    const int index = profileThreadCount.fetch_add(1);
+    if (index >= MAX_PROFILE_THREADS) {
+        profileThreadCount--;
+        currentThreadFull = true;
+        return nullptr;
+    }
+    currentThread = new ProfileThread();  // Kept until the program exits, so traces include finished threads
+    currentThread->id = index + 1;
+    profileThreads[index].store(currentThread, std::memory_order_release);
+    return currentThread;
+}
+
+static void WriteEvent(ProfileThread* thread, const char* name, uint64_t start, uint64_t end, ProfileEventKind kind) {
+    const uint64_t index = thread->written.load(std::memory_order_relaxed);
+    ProfileEvent& event = thread->events[index % PROFILE_EVENTS_PER_THREAD];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    event.kind.store(kind, std::memory_order_relaxed);
+    thread->written.store(index + 1, std::memory_order_release);  // Publishes the event
+}
+
+void ProfileRecord(const char* name, uint64_t start, uint64_t end) {
+    ProfileThread* thread = CurrentThread();
+    if (thread != nullptr) WriteEvent(thread, name, start, end, ProfileEventKind::Scope);
+}
+
+int ProfileCounterId(const char* name) {
+    std::lock_guard<std::mutex> lock(counterMutex);
+    const int count = counterCount.load();
+    for (int i = 0; i < count; i++) {
+        if (strcmp(counterNames[i], name) == 0) return i;  // Another call site counts the same thing
+    }
+    if (count == MAX_PROFILE_COUNTERS) return -1;
+    counterNames[count] = name;
+    counterCount.store(count + 1);
+    return count;
+}
+
+void ProfileCount(int counter, uint64_t amount) {
+    ProfileThread* thread = CurrentThread();
+    if (thread == nullptr || counter < 0) return;
+    std::atomic<uint64_t>& value = thread->counters[counter];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);  // Only this thread writes it
+}
+
+void ProfileSetThreadName(const char* name) {
+    ProfileThread* thread = CurrentThread();
+    if (thread != nullptr) thread->name.store(name, std::memory_order_relaxed);
+}
+
+void ProfileFrameBegin() {
+    const uint64_t now = ProfileNow();
+    if (frameStart != 0) frameIntervals[intervalCount++ % PROFILE_FRAME_HISTORY] = (now - frameStart) / 1e6;
+    frameStart = now;
+}
+
+void ProfileFrameEnd() {
+    const uint64_t now = ProfileNow();
+    if (frameStart == 0) frameStart = now;  // First frame: nothing to measure yet
+    ProfileRecord("Frame", frameStart, now);
+    frameTimes[frameCount % PROFILE_FRAME_HISTORY] = (now - frameStart) / 1e6;
+    frameCount++;
+
+    // Sum the counters of every thread and keep what this frame added. Changes also go into the
+    // trace as counter events.
+    ProfileThread* self = CurrentThread();
+    const int counters = counterCount.load();
+    const int threads = std::min(profileThreadCount.load(), MAX_PROFILE_THREADS);
+    for (int c = 0; c < counters; c++) {
+        uint64_t total = 0;
+        for (int t = 0; t < threads; t++) {
+            const ProfileThread* thread = profileThreads[t].load(std::memory_order_acquire);
+            if (thread != nullptr) total += thread->counters[c].load(std::memory_order_relaxed);
+        }
+        const uint64_t frameValue = total - counterTotals[c];
+        if (frameValue != lastFrameCounts[c] && self != nullptr) WriteEvent(self, counterNames[c], now, frameValue, ProfileEventKind::Counter);
+        counterTotals[c] = total;
+        lastFrameCounts[c] = frameValue;
+    }
+}
+
+void GetProfileFrameReport(ProfileFrameReport& report) {
+    report = ProfileFrameReport();
+    report.frames = std::min(frameCount, PROFILE_FRAME_HISTORY);
+    if (report.frames > 0) {
+        double sorted[PROFILE_FRAME_HISTORY];
+        std::copy(frameTimes, frameTimes + report.frames, sorted);
+        std::sort(sorted, sorted + report.frames);
+        auto percentile = [&](double fraction) { return sorted[std::min(report.frames - 1, (int)(fraction * report.frames))]; };
+        report.p50 = percentile(0.50);
+        report.p95 = percentile(0.95);
+        report.p99 = percentile(0.99);
+        report.max = sorted[report.frames - 1];
+
+        const int intervals = std::min(intervalCount, PROFILE_FRAME_HISTORY);  // The slots written so far
+        double total = 0.0;
+        for (int i = 0; i < intervals; i++) total += frameIntervals[i];
+        report.fps = total > 0.0 ? intervals * 1000.0 / total : 0.0;
+    }
+
+    report.counterCount = counterCount.load();
+    for (int c = 0; c < report.counterCount; c++) {
+        report.counterNames[c] = counterNames[c];
+        report.counterValues[c] = lastFrameCounts[c];
+    }
+}
+
+// Copy the events of a buffer that were not overwritten while they were read
+static void CopyEvents(const ProfileThread& thread, std::vector<ProfileSample>& samples) {
+    const uint64_t written = thread.written.load(std::memory_order_acquire);
+    const uint64_t first = written > PROFILE_EVENTS_PER_THREAD ? written - PROFILE_EVENTS_PER_THREAD : 0;
+    const size_t begin = samples.size();
+    for (uint64_t i = first; i < written; i++) {
+        const ProfileEvent& event = thread.events[i % PROFILE_EVENTS_PER_THREAD];
+        ProfileSample sample;
+        sample.name = event.name.load(std::memory_order_relaxed);
+        sample.start = event.start.load(std::memory_order_relaxed);
+        sample.end = event.end.load(std::memory_order_relaxed);
+        sample.kind = event.kind.load(std::memory_order_relaxed);
+        sample.thread = thread.id;
+        samples.push_back(sample);
+    }
+
+    // The owner kept writing: drop the slots it may have reused meanwhile. It writes event
+    // `writtenAfter` before publishing it, so the slot of event writtenAfter - N may be half
+    // overwritten too (the same check as a seqlock's).
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t writtenAfter = thread.written.load(std::memory_order_relaxed);
+    const uint64_t overwritten = writtenAfter + 1 > PROFILE_EVENTS_PER_THREAD ? writtenAfter + 1 - PROFILE_EVENTS_PER_THREAD : 0;
+    if (overwritten > first) {
+        const size_t drop = (size_t)std::min(overwritten - first, written - first);
+        samples.erase(samples.begin() + begin, samples.begin() + begin + drop);
+    }
+}
+
+// Names are literals from the code, but keep the JSON valid whatever they contain
+static void WriteJsonString(std::ofstream& output, const char* text) {
+    output << '"';
+    for (const char* c = text ? text : "?"; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') output << '\\';
+        if ((unsigned char)*c >= 0x20) output << *c;
+    }
+    output << '"';
+}
+
+bool ExportChromeTrace(const std::string& path, std::string& error) {
+    std::vector<ProfileSample> samples;
+    samples.reserve(PROFILE_EVENTS_PER_THREAD * 4);
+    const int threads = std::min(profileThreadCount.load(), MAX_PROFILE_THREADS);
+    for (int t = 0; t < threads; t++) {
+        const ProfileThread* thread = profileThreads[t].load(std::memory_order_acquire);
+        if (thread != nullptr) CopyEvents(*thread, samples);
+    }
+
+    std::ofstream output(path, std::ios::trunc);
+    if (!output) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const char* separator = "";
+    char line[160];
+    for (int t = 0; t < threads; t++) {
+        const ProfileThread* thread = profileThreads[t].load(std::memory_order_acquire);
+        if (thread == nullptr) continue;
+        const char* name = thread->name.load(std::memory_order_relaxed);
+        snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", separator, thread->id);
+        output << line;
+        WriteJsonString(output, name ? name : "Thread");
+        output << "}}";
+        separator = ",\n";
+    }
+    for (const ProfileSample& sample : samples) {
+        output << separator << "{\"name\":";
+        WriteJsonString(output, sample.name);
+        if (sample.kind == ProfileEventKind::Scope) {
+            snprintf(line, sizeof(line), ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", sample.thread,
+                (sample.start - profileStart) / 1000.0, (sample.end - sample.start) / 1000.0);
+        }
+        else {
+            snprintf(line, sizeof(line), ",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"per frame\":%llu}}", sample.thread,
+                (sample.start - profileStart) / 1000.0, (unsigned long long)sample.end);
+        }
+        output << line;
+        separator = ",\n";
+    }
+    output << "\n]}\n";
+    output.close();
+    if (!output) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+#include <chrono>   // For timestamps
+#include <cstddef>  // For size_t
+#include <cstdint>  // For fixed-width integer types
+#include <string>   // For trace file paths and error messages
+
+// Hot-path instrumentation: scoped timers and counters that cost a few nanoseconds each.
+//
+//   PROFILE_SCOPE("Draw board");         time the rest of the enclosing block
+//   PROFILE_COUNT("draw calls", 2);      add to a counter (reported per frame)
+//   PROFILE_THREAD_NAME("Pool worker");  label the calling thread in traces
+//   PROFILE_FRAME_END();                 before EndDrawing(): the frame's work is done
+//   PROFILE_FRAME_BEGIN();               after EndDrawing(): the next frame starts
+//
+// Every thread writes its own ring buffer of the most recent events, so recording never takes a
+// lock or allocates after the thread's first event. Other threads only read the buffers (for the
+// overlay and for ExportChromeTrace). The macros compile to nothing unless CODEHOLICS_PROFILE is
+// defined; the Debug configurations of the game project define it, Release builds, the benchmark
+// and the server do not.
+
+#ifdef CODEHOLICS_PROFILE
+
+const size_t PROFILE_EVENTS_PER_THREAD = 16384;  // Ring buffer size, older events are overwritten
+const int MAX_PROFILE_THREADS = 64;              // Threads after this many are not recorded
+const int MAX_PROFILE_COUNTERS = 32;             // Distinct counter names
+const int PROFILE_FRAME_HISTORY = 240;           // Frames the percentiles cover (4 seconds at 60 FPS)
+
+// Nanoseconds on a steady clock
+inline uint64_t ProfileNow() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ProfileRecord(const char* name, uint64_t start, uint64_t end);  // Add a finished scope to this thread's buffer
+int ProfileCounterId(const char* name);                              // Slot of a counter (registered once per call site)
+void ProfileCount(int counter, uint64_t amount);
+void ProfileSetThreadName(const char* name);                         // `name` must outlive the program (a literal)
+void ProfileFrameBegin();
+void ProfileFrameEnd();
+
+// Times the block it is declared in
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(ProfileNow()) {}
+    ~ProfileScope() { ProfileRecord(name, start, ProfileNow()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+// What the overlay shows
+struct ProfileFrameReport {
+    int frames = 0;                    // Frames measured (up to PROFILE_FRAME_HISTORY)
+    double p50 = 0.0;                  // Frame work time percentiles in milliseconds
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double fps = 0.0;                  // From the average time between frame starts
+    int counterCount = 0;
+    const char* counterNames[MAX_PROFILE_COUNTERS] = {};
+    uint64_t counterValues[MAX_PROFILE_COUNTERS] = {};  // Counted during the last frame, by every thread
+};
+
+void GetProfileFrameReport(ProfileFrameReport& report);  // Call from the thread that marks the frames
+
+// Write the events still in the buffers as Chrome trace JSON (chrome://tracing or ui.perfetto.dev)
+bool ExportChromeTrace(const std::string& path, std::string& error);
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_COUNT(name, amount) do { static const int profileCounter = ProfileCounterId(name); ProfileCount(profileCounter, (uint64_t)(amount)); } while (0)
+#define PROFILE_THREAD_NAME(name) ProfileSetThreadName(name)
+#define PROFILE_FRAME_BEGIN() ProfileFrameBegin()
+#define PROFILE_FRAME_END() ProfileFrameEnd()
+
+#else
+
+#define PROFILE_SCOPE(name) do { } while (0)
+#define PROFILE_COUNT(name, amount) do { } while (0)
+#define PROFILE_THREAD_NAME(name) do { } while (0)
+#define PROFILE_FRAME_BEGIN() do { } while (0)
+#define PROFILE_FRAME_END() do { } while (0)
+
+#endif
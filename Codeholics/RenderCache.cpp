@@ -0,0 +1,79 @@
+#include "RenderCache.h"
+#include "rlgl.h"   // For copying the cached screen without blending
+#include "Profiler.h" // For counting draw calls
+#include <cstring>  // For strncmp, strnlen and memcpy
+
+const char* LetterText(char letter) {
+    static char letters[256][2];  // Every byte followed by a terminator, filled on first use
+    static bool filled = false;
+    if (!filled) {
+        for (int c = 0; c < 256; c++) {
+            letters[c][0] = (char)c;
+            letters[c][1] = '\0';
+        }
+        filled = true;
+    }
+    return letters[(unsigned char)letter];
+}
+
+void DrawScreenText(const char* text, int x, int y, int fontSize, Color color) {
+    PROFILE_COUNT("draw calls", 1);
+    DrawText(text, x, y, fontSize, color);
+}
+
+void DrawScreenRectangle(int x, int y, int width, int height, Color color) {
+    PROFILE_COUNT("draw calls", 1);
+    DrawRectangle(x, y, width, height, color);
+}
+
+bool CachedText::Set(const char* newText, int newFontSize, int newMaxWidth) {
+    if (newFontSize == requestedSize && newMaxWidth == maxWidth && strncmp(newText, text, CAPACITY - 1) == 0) return false;  // Same text, keep the layout
+    const size_t length = strnlen(newText, CAPACITY - 1);
+    memcpy(text, newText, length);
+    text[length] = '\0';
+    requestedSize = newFontSize;
+    maxWidth = newMaxWidth;
+    fontSize = newFontSize;
+    width = MeasureText(text, fontSize);
+    if (maxWidth > 0 && width > maxWidth && fontSize > 10) {
+        fontSize = (fontSize / 2 > 10) ? fontSize / 2 : 10;  // Too wide, use a smaller font
+        width = MeasureText(text, fontSize);
+    }
+    return true;
+}
+
+CachedScreen::~CachedScreen() {
+    if (target.id != 0) UnloadRenderTexture(target);
+}
+
+void CachedScreen::BeginRebuild() {
+    if (target.id == 0) target = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+    BeginTextureMode(target);
+}
+
+void CachedScreen::EndRebuild() {
+    EndTextureMode();
+    dirty = false;
+    rebuilds++;
+}
+
+void CachedScreen::Draw() const {
+    // Copy the pixels as they are: blending would mix the texture's alpha into the edges of the text
+    if (target.id == 0) return;  // Nothing was built yet
+    PROFILE_COUNT("draw calls", 1);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    Rectangle source = { 0, 0, (float)target.texture.width, -(float)target.texture.height };  // Render textures are upside down
+    DrawTextureRec(target.texture, source, Vector2{ 0, 0 }, WHITE);
+    EndBlendMode();
+}
+
+void FramePacer::SetIdle(bool idle) {
+    if (idle && !waiting) EnableEventWaiting();
+    else if (!idle && waiting) DisableEventWaiting();
+    waiting = idle;
+}
+
+FramePacer::~FramePacer() {
+    if (waiting) DisableEventWaiting();
+}
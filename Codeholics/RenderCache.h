@@ -0,0 +1,78 @@
+#pragma once
+#include "raylib.h"  // For render textures, text measuring and event waiting
+#include <cstddef>   // For size_t
+
+// Retained rendering: a screen is drawn into a render texture only when something on it changed,
+// and every frame just copies that texture to the window. Text that is drawn from dynamic values
+// keeps its formatted string and measured width, so neither is redone while the value stays the same.
+
+// One-letter string for drawing a letter (no temporary strings per cell)
+const char* LetterText(char letter);
+
+// DrawText and DrawRectangle that add to the profiler's "draw calls" counter. Screens draw through
+// these, so the counter is the number of calls that were made.
+void DrawScreenText(const char* text, int x, int y, int fontSize, Color color);
+void DrawScreenRectangle(int x, int y, int width, int height, Color color);
+
+// Text that is formatted and measured only when it changes
+class CachedText {
+public:
+    // Store `text` and measure it at `fontSize`, halving the size (down to 10) if it is wider than
+    // `maxWidth` (0 = any width). Returns true if anything changed.
+    bool Set(const char* text, int fontSize, int maxWidth = 0);
+    const char* Text() const { return text; }
+    int Width() const { return width; }
+    int FontSize() const { return fontSize; }
+
+private:
+    static const size_t CAPACITY = 128;  // Longer text is cut off
+    char text[CAPACITY] = { 0 };
+    int requestedSize = 0;  // Arguments of the last Set
+    int maxWidth = 0;
+    int fontSize = 0;       // Layout that fits
+    int width = 0;
+};
+
+// A whole screen kept in a render texture
+class CachedScreen {
+public:
+    CachedScreen() = default;
+    ~CachedScreen();
+
+    CachedScreen(const CachedScreen&) = delete;
+    CachedScreen& operator=(const CachedScreen&) = delete;
+
+    void Invalidate() { dirty = true; }   // Redraw the screen on the next frame
+    bool IsDirty() const { return dirty; }
+
+    // Draw calls between these two go into the cached screen instead of the window
+    void BeginRebuild();
+    void EndRebuild();
+
+    // Copy the cached screen to the window (call between BeginDrawing and EndDrawing)
+    void Draw() const;
+
+    int Rebuilds() const { return rebuilds; }
+
+private:
+    RenderTexture2D target = {};  // Created on the first rebuild, once the window exists
+    bool dirty = true;
+    int rebuilds = 0;
+};
+
+// Skips frames while nothing can change: when idle, EndDrawing() sleeps until the next input event
+// instead of running the loop 60 times a second.
+class FramePacer {
+public:
+    // Call once per frame before EndDrawing(). Screens that change without input (like a running
+    // hint search) are not idle.
+    void SetIdle(bool idle);
+    ~FramePacer();
+
+    void CountFrame() { frames++; }
+    int Frames() const { return frames; }
+
+private:
+    bool waiting = false;  // Event waiting is enabled
+    int frames = 0;
+};
@@ -0,0 +1,238 @@
+#include "Scoring.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SCORING_X86 1
+#include <immintrin.h>  // SSE2 and AVX2 intrinsics
+#ifdef _MSC_VER
+#include <intrin.h>     // For __cpuid and _xgetbv
+#endif
+#endif
+
+#if defined(SCORING_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+// The batch kernels use a branch-free form of CheckGuess's two passes. Letter i of the guess is
+// present when it is not correct and the number of earlier non-correct copies of the same letter
+// in the guess is smaller than the number of non-correct copies of that letter in the answer.
+//
+// The kernels are templates on the word length, so every loop below has a constant trip count
+// and is unrolled for each length. Vector lanes are bytes, so the first five letters are summed
+// into `low` (base-3 value below 243) and the rest into `high`; for longer words the two are
+// combined as low + 243 * high in 16-bit lanes when storing.
+
+// Score words [begin, end) one at a time
+template <int L>
+static void CheckGuessScalar(const char* guess, const WordPlanes& answers, size_t begin, size_t end, Pattern<L>* patterns) {
+    for (size_t w = begin; w < end; w++) {
+        uint8_t letters[L];
+        bool correct[L];
+        for (int i = 0; i < L; i++) {
+            letters[i] = answers.letters[i * answers.stride + w];
+            correct[i] = letters[i] == (uint8_t)guess[i];
+        }
+
+        int pattern = 0;
+        for (int i = 0, weight = 1; i < L; i++, weight *= 3) {
+            if (correct[i]) {
+                pattern += 2 * weight;
+                continue;
+            }
+            int available = 0;  // Unmatched copies of this letter in the answer
+            int earlier = 0;    // Unmatched copies already claimed by earlier letters of the guess
+            for (int j = 0; j < L; j++) {
+                available += !correct[j] && letters[j] == (uint8_t)guess[i];
+                earlier += j < i && !correct[j] && guess[j] == guess[i];
+            }
+            if (earlier < available) pattern += weight;
+        }
+        patterns[w - begin] = (Pattern<L>)pattern;
+    }
+}
+
+#ifdef SCORING_X86
+
+// Weight of letter i inside its byte accumulator
+static inline char LaneWeight(int i, int feedback) {
+    return (char)(feedback * PowerOf3(i < 5 ? i : i - 5));
+}
+
+static inline void StorePatterns(uint8_t* patterns, __m128i low, __m128i) {
+    _mm_storeu_si128((__m128i*)patterns, low);
+}
+
+static inline void StorePatterns(uint16_t* patterns, __m128i low, __m128i high) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(243);
+    __m128i first = _mm_add_epi16(_mm_unpacklo_epi8(low, zero), _mm_mullo_epi16(_mm_unpacklo_epi8(high, zero), scale));
+    __m128i second = _mm_add_epi16(_mm_unpackhi_epi8(low, zero), _mm_mullo_epi16(_mm_unpackhi_epi8(high, zero), scale));
+    _mm_storeu_si128((__m128i*)patterns, first);
+    _mm_storeu_si128((__m128i*)(patterns + 8), second);
+}
+
+// Score 16 words at a time with SSE2 (always available on x64), starting at word `first`
+template <int L>
+static void CheckGuessSse2(const char* guess, const WordPlanes& answers, size_t first, size_t blocks, Pattern<L>* patterns) {
+    const __m128i ones = _mm_set1_epi8(-1);
+
+    for (size_t half = 0; half < blocks * 2; half++) {
+        const size_t offset = first + half * 16;
+        __m128i letters[L];
+        __m128i unmatched[L];  // 0xFF where the answer letter is not a correct match
+        __m128i low = _mm_setzero_si128();
+        __m128i high = _mm_setzero_si128();
+
+        for (int i = 0; i < L; i++) {
+            letters[i] = _mm_loadu_si128((const __m128i*)(answers.letters + i * answers.stride + offset));
+            __m128i correct = _mm_cmpeq_epi8(letters[i], _mm_set1_epi8(guess[i]));
+            unmatched[i] = _mm_andnot_si128(correct, ones);
+            __m128i points = _mm_and_si128(correct, _mm_set1_epi8(LaneWeight(i, FEEDBACK_CORRECT)));
+            if (i < 5) low = _mm_add_epi8(low, points);
+            else high = _mm_add_epi8(high, points);
+        }
+
+        for (int i = 0; i < L; i++) {
+            const __m128i letter = _mm_set1_epi8(guess[i]);
+            __m128i available = _mm_setzero_si128();
+            __m128i earlier = _mm_setzero_si128();
+            for (int j = 0; j < L; j++) {
+                // Comparison masks are -1, so subtracting them counts matches
+                available = _mm_sub_epi8(available, _mm_and_si128(unmatched[j], _mm_cmpeq_epi8(letters[j], letter)));
+                if (j < i && guess[j] == guess[i]) earlier = _mm_sub_epi8(earlier, unmatched[j]);
+            }
+            __m128i present = _mm_and_si128(unmatched[i], _mm_cmpgt_epi8(available, earlier));
+            __m128i points = _mm_and_si128(present, _mm_set1_epi8(LaneWeight(i, FEEDBACK_PRESENT)));
+            if (i < 5) low = _mm_add_epi8(low, points);
+            else high = _mm_add_epi8(high, points);
+        }
+
+        StorePatterns(patterns + half * 16, low, high);
+    }
+}
+
+TARGET_AVX2 static inline void StorePatterns(uint8_t* patterns, __m256i low, __m256i) {
+    _mm256_storeu_si256((__m256i*)patterns, low);
+}
+
+TARGET_AVX2 static inline void StorePatterns(uint16_t* patterns, __m256i low, __m256i high) {
+    const __m256i scale = _mm256_set1_epi16(243);
+    __m256i first = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(low)),
+        _mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(high)), scale));
+    __m256i second = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(low, 1)),
+        _mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(high, 1)), scale));
+    _mm256_storeu_si256((__m256i*)patterns, first);
+    _mm256_storeu_si256((__m256i*)(patterns + 16), second);
+}
+
+// Same as CheckGuessSse2 with 32-lane AVX2 vectors
+template <int L>
+TARGET_AVX2 static void CheckGuessAvx2(const char* guess, const WordPlanes& answers, size_t first, size_t blocks, Pattern<L>* patterns) {
+    const __m256i ones = _mm256_set1_epi8(-1);
+
+    for (size_t block = 0; block < blocks; block++) {
+        const size_t offset = first + block * WORD_BLOCK;
+        __m256i letters[L];
+        __m256i unmatched[L];
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+
+        for (int i = 0; i < L; i++) {
+            letters[i] = _mm256_loadu_si256((const __m256i*)(answers.letters + i * answers.stride + offset));
+            __m256i correct = _mm256_cmpeq_epi8(letters[i], _mm256_set1_epi8(guess[i]));
+            unmatched[i] = _mm256_andnot_si256(correct, ones);
+            __m256i points = _mm256_and_si256(correct, _mm256_set1_epi8(LaneWeight(i, FEEDBACK_CORRECT)));
+            if (i < 5) low = _mm256_add_epi8(low, points);
+            else high = _mm256_add_epi8(high, points);
+        }
+
+        for (int i = 0; i < L; i++) {
+            const __m256i letter = _mm256_set1_epi8(guess[i]);
+            __m256i available = _mm256_setzero_si256();
+            __m256i earlier = _mm256_setzero_si256();
+            for (int j = 0; j < L; j++) {
+                available = _mm256_sub_epi8(available, _mm256_and_si256(unmatched[j], _mm256_cmpeq_epi8(letters[j], letter)));
+                if (j < i && guess[j] == guess[i]) earlier = _mm256_sub_epi8(earlier, unmatched[j]);
+            }
+            __m256i present = _mm256_and_si256(unmatched[i], _mm256_cmpgt_epi8(available, earlier));
+            __m256i points = _mm256_and_si256(present, _mm256_set1_epi8(LaneWeight(i, FEEDBACK_PRESENT)));
+            if (i < 5) low = _mm256_add_epi8(low, points);
+            else high = _mm256_add_epi8(high, points);
+        }
+
+        StorePatterns(patterns + block * WORD_BLOCK, low, high);
+    }
+}
+
+// Check once whether the CPU and the OS support AVX2
+static bool DetectAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // OS must save YMM registers
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const bool HAS_AVX2 = DetectAvx2();
+
+#endif
+
+// Score `blocks` whole blocks starting at word `first` with the best kernel for this CPU
+template <int L>
+static void CheckGuessBlocks(const char* guess, const WordPlanes& answers, size_t first, size_t blocks, Pattern<L>* patterns) {
+#ifdef SCORING_X86
+    if (HAS_AVX2) CheckGuessAvx2<L>(guess, answers, first, blocks, patterns);
+    else CheckGuessSse2<L>(guess, answers, first, blocks, patterns);
+#else
+    CheckGuessScalar<L>(guess, answers, first, first + blocks * WORD_BLOCK, patterns);
+#endif
+}
+
+template <int L>
+void CheckGuessBatch(const char* guess, const WordPlanes& answers, Pattern<L>* patterns) {
+    const size_t blocks = answers.count / WORD_BLOCK;  // Whole blocks can be written straight to the output
+    CheckGuessBlocks<L>(guess, answers, 0, blocks, patterns);
+
+    const size_t done = blocks * WORD_BLOCK;
+    if (done < answers.count) {
+        // The planes are padded to a whole block, so score the last block into a buffer
+        Pattern<L> last[WORD_BLOCK];
+        CheckGuessBlocks<L>(guess, answers, done, 1, last);
+        for (size_t w = done; w < answers.count; w++) patterns[w] = last[w - done];
+    }
+}
+
+template <int L>
+void CheckGuessBlock(const char* guess, const WordPlanes& answers, size_t first, Pattern<L>* patterns) {
+    CheckGuessBlocks<L>(guess, answers, first, 1, patterns);
+}
+
+// Every supported word length gets its own copy of the kernels
+template void CheckGuessBatch<4>(const char*, const WordPlanes&, Pattern<4>*);
+template void CheckGuessBatch<5>(const char*, const WordPlanes&, Pattern<5>*);
+template void CheckGuessBatch<6>(const char*, const WordPlanes&, Pattern<6>*);
+template void CheckGuessBatch<7>(const char*, const WordPlanes&, Pattern<7>*);
+template void CheckGuessBatch<8>(const char*, const WordPlanes&, Pattern<8>*);
+template void CheckGuessBlock<4>(const char*, const WordPlanes&, size_t, Pattern<4>*);
+template void CheckGuessBlock<5>(const char*, const WordPlanes&, size_t, Pattern<5>*);
+template void CheckGuessBlock<6>(const char*, const WordPlanes&, size_t, Pattern<6>*);
+template void CheckGuessBlock<7>(const char*, const WordPlanes&, size_t, Pattern<7>*);
+template void CheckGuessBlock<8>(const char*, const WordPlanes&, size_t, Pattern<8>*);
+
+const char* ScoringKernelName() {
+#ifdef SCORING_X86
+    return HAS_AVX2 ? "avx2" : "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>      // For size_t
+#include <cstdint>      // For fixed-width integer types like uint8_t
+#include <string>       // For the std::string convenience overload
+#include <type_traits>  // For std::conditional
+#include <vector>       // For the storage behind packed word lists
+
+// Game Constants of the classic game (one board, five letters)
+const int MAX_GUESSES = 6;      // Maximum number of guesses allowed
+const int WORD_LENGTH = 5;      // Length of the secret word
+
+// Word lengths the game can be built for
+const int MIN_WORD_LENGTH = 4;
+const int MAX_WORD_LENGTH = 8;
+
+// Feedback values for a single letter (one base-3 digit of a pattern)
+const int FEEDBACK_ABSENT = 0;   // Letter is not in the word
+const int FEEDBACK_PRESENT = 1;  // Letter is in the word, but in another position
+const int FEEDBACK_CORRECT = 2;  // Letter is in the correct position
+
+constexpr int PowerOf3(int exponent) {
+    return exponent == 0 ? 1 : 3 * PowerOf3(exponent - 1);
+}
+
+// A pattern packs the feedback of a whole guess into one number: digit i (base 3) is the
+// feedback for letter i. Up to 5 letters fit in a byte, longer words need 16 bits.
+template <int L>
+struct PatternTraits {
+    static_assert(L >= MIN_WORD_LENGTH && L <= MAX_WORD_LENGTH, "Unsupported word length");
+    typedef typename std::conditional<(L <= 5), uint8_t, uint16_t>::type Type;
+    static const int COUNT = PowerOf3(L);       // Number of different patterns
+    static const Type SOLVED = (Type)(COUNT - 1);  // Every letter correct
+};
+
+template <int L>
+using Pattern = typename PatternTraits<L>::Type;
+
+// Number of words processed together by the batch scoring kernels
+const size_t WORD_BLOCK = 32;
+
+// Read-only view of a word list stored position by position:
+// letters[position * stride + index] is letter `position` of word `index`.
+// Padding after `count` is filled with zeros so it never matches a guess.
+struct WordPlanes {
+    const uint8_t* letters = nullptr;  // One plane of `stride` bytes per letter position
+    size_t count = 0;                  // Number of words in the list
+    size_t stride = 0;                 // Bytes per plane (count rounded up to WORD_BLOCK)
+};
+
+// Word list that owns its planes (for lists built at runtime)
+struct PackedWords {
+    std::vector<uint8_t> letters;  // Storage for the planes
+    size_t count = 0;              // Number of words
+    size_t stride = 0;             // Bytes per plane
+
+    WordPlanes View() const {
+        WordPlanes view;
+        view.letters = letters.data();
+        view.count = count;
+        view.stride = stride;
+        return view;
+    }
+};
+
+// Round a word count up to a whole number of blocks
+inline size_t PlaneStride(size_t count) {
+    return (count + WORD_BLOCK - 1) / WORD_BLOCK * WORD_BLOCK;
+}
+
+// Lay out a list of L-letter words position by position for CheckGuessBatch
+template <int L>
+PackedWords PackWords(const std::vector<std::string>& words) {
+    PackedWords packed;
+    packed.count = words.size();
+    packed.stride = PlaneStride(words.size());
+    packed.letters.assign(packed.stride * L, 0);  // Zero padding never matches a letter
+
+    for (size_t w = 0; w < words.size(); w++) {
+        for (int i = 0; i < L && i < (int)words[w].size(); i++) {
+            packed.letters[i * packed.stride + w] = (uint8_t)words[w][i];
+        }
+    }
+    return packed;
+}
+
+// Function to compare a guess with the answer and return the packed feedback pattern
+template <int L>
+Pattern<L> CheckGuess(const char* guess, const char* word) {
+    int result[L] = { 0 };  // 0 = absent, 1 = present, 2 = correct
+    char usedWord[L];       // Copy of the word to mark used letters
+    for (int i = 0; i < L; i++) usedWord[i] = word[i];
+
+    // First pass: Check for correct letters in the correct positions
+    for (int i = 0; i < L; i++) {
+        if (guess[i] == usedWord[i]) {
+            result[i] = FEEDBACK_CORRECT;  // Mark as correct
+            usedWord[i] = '*';             // Mark the letter as used in the word
+        }
+    }
+
+    // Second pass: Check for correct letters in the wrong positions
+    int pattern = 0;
+    int weight = 1;
+    for (int i = 0; i < L; i++) {
+        if (result[i] != FEEDBACK_CORRECT) {  // Skip already matched letters
+            for (int j = 0; j < L; j++) {
+                if (guess[i] == usedWord[j]) {
+                    result[i] = FEEDBACK_PRESENT;  // Mark as present but misplaced
+                    usedWord[j] = '*';             // Mark this letter as used
+                    break;
+                }
+            }
+        }
+        pattern += result[i] * weight;
+        weight *= 3;
+    }
+
+    return (Pattern<L>)pattern;
+}
+
+inline Pattern<WORD_LENGTH> CheckGuess(const std::string& guess, const std::string& word) {
+    return CheckGuess<WORD_LENGTH>(guess.c_str(), word.c_str());
+}
+
+// Score one guess against every word in `answers`, writing answers.count patterns.
+// Gives the same results as calling CheckGuess once per answer.
+template <int L>
+void CheckGuessBatch(const char* guess, const WordPlanes& answers, Pattern<L>* patterns);
+
+// Score one guess against the WORD_BLOCK words starting at `first` (which must be a multiple of
+// WORD_BLOCK), writing WORD_BLOCK patterns. Used to score every board of a game in one pass.
+template <int L>
+void CheckGuessBlock(const char* guess, const WordPlanes& answers, size_t first, Pattern<L>* patterns);
+
+// Read the feedback (FEEDBACK_ABSENT/PRESENT/CORRECT) of one letter from a pattern
+inline int PatternFeedback(int pattern, int position) {
+    static const int POWERS_OF_3[MAX_WORD_LENGTH] = { 1, 3, 9, 27, 81, 243, 729, 2187 };
+    return pattern / POWERS_OF_3[position] % 3;
+}
+
+// Name of the kernel CheckGuessBatch uses on this machine ("avx2", "sse2" or "scalar")
+const char* ScoringKernelName();
@@ -0,0 +1,213 @@
+#include "Solver.h"
+#include "Profiler.h" // For timing the search tasks
+#include <algorithm> // For std::min and std::fill
+#include <atomic>    // For the cancel flag and the chunk counter
+#include <cmath>     // For std::log2
+
+static const size_t GUESSES_PER_TASK = 256;  // Guesses scored by one pool task
+
+// State of one hint search, shared by the solver and the pool tasks working on it
+template <int L>
+struct Solver<L>::Search {
+    std::vector<std::string> guesses;  // Guess and feedback history the search is for
+    std::vector<Pattern<L>> feedbacks;
+    PackedWords candidates;            // Answers that match every feedback so far
+    std::string candidateWords;        // The same answers back to back, tried as guesses first
+    std::atomic<bool> cancelled{ false };
+    std::atomic<size_t> chunksLeft{ 0 };
+    size_t chunkCount = 0;
+    std::mutex mutex;                  // Guards best and bestIsCandidate
+    Hint best;
+    bool bestIsCandidate = false;      // Whether the best guess could be the answer itself
+};
+
+template <int L>
+Solver<L>::Solver(const SolverWords& words, ThreadPool& pool)
+    : words(words), pool(pool) {
+    openingSearch = StartSearch(std::vector<std::string>(), std::vector<Pattern<L>>());  // Warm the opening cache right away
+}
+
+template <int L>
+Solver<L>::~Solver() {
+    openingSearch->cancelled = true;  // Let queued tasks return at once
+    {
+        std::lock_guard<std::mutex> lock(searchMutex);
+        if (currentSearch) currentSearch->cancelled = true;
+    }
+
+    // The pool outlives the solver, so wait until no task can touch it any more
+    std::unique_lock<std::mutex> lock(tasksMutex);
+    tasksDone.wait(lock, [this] { return tasksQueued == 0; });
+}
+
+template <int L>
+void Solver<L>::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasksQueued++;
+    }
+    pool.Submit([this, task] {
+        task();
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        if (--tasksQueued == 0) tasksDone.notify_all();
+    });
+}
+
+template <int L>
+void Solver<L>::RequestHint(const std::vector<std::string>& guesses, const std::vector<Pattern<L>>& feedbacks) {
+    std::shared_ptr<Search> search = guesses.empty() ? openingSearch : StartSearch(guesses, feedbacks);
+    std::lock_guard<std::mutex> lock(searchMutex);
+    if (currentSearch && currentSearch != openingSearch) currentSearch->cancelled = true;
+    currentSearch = search;
+}
+
+template <int L>
+void Solver<L>::CancelHint() {
+    std::lock_guard<std::mutex> lock(searchMutex);
+    if (currentSearch && currentSearch != openingSearch) currentSearch->cancelled = true;  // The opening search is always kept
+    currentSearch.reset();
+}
+
+template <int L>
+Hint Solver<L>::CurrentHint() const {
+    std::shared_ptr<Search> search;
+    {
+        std::lock_guard<std::mutex> lock(searchMutex);
+        search = currentSearch;
+    }
+    if (!search) return Hint();
+
+    std::lock_guard<std::mutex> lock(search->mutex);
+    return search->best;
+}
+
+template <int L>
+std::shared_ptr<typename Solver<L>::Search> Solver<L>::StartSearch(const std::vector<std::string>& guesses, const std::vector<Pattern<L>>& feedbacks) {
+    std::shared_ptr<Search> search = std::make_shared<Search>();
+    search->guesses = guesses;
+    search->feedbacks = feedbacks;
+    Submit([this, search] { FindCandidates(search); });
+    return search;
+}
+
+// Narrow the answers down to the ones that match the feedback so far, then queue the guess scoring
+template <int L>
+void Solver<L>::FindCandidates(const std::shared_ptr<Search>& search) {
+    if (search->cancelled) return;
+    PROFILE_SCOPE("Hint candidates");
+
+    const WordPlanes& answers = words.answers;
+    std::vector<uint8_t> possible(answers.count, 1);
+    std::vector<Pattern<L>> patterns(answers.count);
+    for (size_t i = 0; i < search->guesses.size(); i++) {
+        CheckGuessBatch<L>(search->guesses[i].c_str(), answers, patterns.data());
+        for (size_t a = 0; a < answers.count; a++) {
+            possible[a] &= (uint8_t)(patterns[a] == search->feedbacks[i]);
+        }
+    }
+
+    std::vector<std::string> candidates;
+    for (size_t a = 0; a < answers.count; a++) {
+        if (!possible[a]) continue;
+        std::string word(L, ' ');
+        for (int i = 0; i < L; i++) word[i] = (char)answers.letters[i * answers.stride + a];
+        candidates.push_back(word);
+        search->candidateWords += word;
+    }
+    search->candidates = PackWords<L>(candidates);
+
+    {
+        std::lock_guard<std::mutex> lock(search->mutex);
+        search->best.candidates = candidates.size();
+        if (candidates.size() <= 2) {
+            // With one or two answers left, guessing one of them is always best
+            if (!candidates.empty()) search->best.guess = candidates[0];
+            search->best.bits = (candidates.size() == 2) ? 1.0 : 0.0;
+            search->best.progress = 1.0f;
+            search->best.finished = true;
+            return;
+        }
+    }
+
+    // Score the remaining answers first (quick, and they can win right away), then every allowed guess
+    const size_t candidateChunks = (candidates.size() + GUESSES_PER_TASK - 1) / GUESSES_PER_TASK;
+    const size_t guessChunks = (words.guessCount + GUESSES_PER_TASK - 1) / GUESSES_PER_TASK;
+    search->chunkCount = candidateChunks + guessChunks;
+    search->chunksLeft = search->chunkCount;
+
+    for (size_t begin = 0; begin < candidates.size(); begin += GUESSES_PER_TASK) {
+        size_t end = std::min(begin + GUESSES_PER_TASK, candidates.size());
+        Submit([this, search, begin, end] { EvaluateGuesses(search, search->candidateWords.data(), begin, end); });
+    }
+    for (size_t begin = 0; begin < words.guessCount; begin += GUESSES_PER_TASK) {
+        size_t end = std::min(begin + GUESSES_PER_TASK, words.guessCount);
+        Submit([this, search, begin, end] { EvaluateGuesses(search, words.guesses, begin, end); });
+    }
+}
+
+// Score guesses [begin, end) of `guessWords` and keep the best one
+template <int L>
+void Solver<L>::EvaluateGuesses(const std::shared_ptr<Search>& search, const char* guessWords, size_t begin, size_t end) {
+    if (search->cancelled) return;
+    PROFILE_SCOPE("Hint scoring");
+    PROFILE_COUNT("hint guesses scored", end - begin);
+
+    const WordPlanes answers = search->candidates.View();
+    const double count = (double)answers.count;
+    std::vector<Pattern<L>> patterns(answers.count);
+    std::vector<uint32_t> patternCounts(PatternTraits<L>::COUNT);  // Up to 6561 counters, too many for the stack
+
+    const char* bestGuess = nullptr;
+    double bestBits = -1.0;
+    for (size_t g = begin; g < end; g++) {
+        if (search->cancelled) return;
+
+        const char* guess = guessWords + g * L;
+        CheckGuessBatch<L>(guess, answers, patterns.data());
+        std::fill(patternCounts.begin(), patternCounts.end(), 0);
+        for (size_t a = 0; a < answers.count; a++) patternCounts[patterns[a]]++;
+
+        // Entropy of the pattern distribution: log2(n) - sum(c * log2(c)) / n
+        double sum = 0.0;
+        for (int p = 0; p < PatternTraits<L>::COUNT; p++) {
+            if (patternCounts[p] > 1) sum += patternCounts[p] * std::log2((double)patternCounts[p]);
+        }
+        double bits = std::log2(count) - sum / count;
+        if (bits > bestBits) {
+            bestBits = bits;
+            bestGuess = guess;
+        }
+    }
+
+    {
+        // On a tie prefer a guess that could be the answer, then the alphabetically first one,
+        // so the result does not depend on which task finished first
+        const bool isCandidate = guessWords == search->candidateWords.data();
+        std::lock_guard<std::mutex> lock(search->mutex);
+        Hint& best = search->best;
+        bool better = best.guess.empty() || bestBits > best.bits
+            || (bestBits == best.bits && (isCandidate > search->bestIsCandidate
+                || (isCandidate == search->bestIsCandidate && best.guess.compare(0, L, bestGuess, L) > 0)));
+        if (bestGuess != nullptr && better) {
+            best.guess.assign(bestGuess, L);
+            best.bits = bestBits;
+            search->bestIsCandidate = isCandidate;
+        }
+    }
+    FinishChunk(search);
+}
+
+template <int L>
+void Solver<L>::FinishChunk(const std::shared_ptr<Search>& search) {
+    size_t left = --search->chunksLeft;
+    std::lock_guard<std::mutex> lock(search->mutex);
+    search->best.progress = 1.0f - (float)left / (float)search->chunkCount;
+    if (left == 0) search->best.finished = true;
+}
+
+// One solver for every supported word length
+template class Solver<4>;
+template class Solver<5>;
+template class Solver<6>;
+template class Solver<7>;
+template class Solver<8>;
@@ -0,0 +1,64 @@
+#pragma once
+#include "Scoring.h"           // For WordPlanes and feedback patterns
+#include "ThreadPool.h"        // The solver spreads its work over all cores
+#include <condition_variable>  // For waiting until the solver's tasks are done
+#include <functional>          // For std::function tasks
+#include <memory>              // For std::shared_ptr
+#include <mutex>               // For guarding the current search and the opening cache
+#include <string>              // For guesses
+#include <vector>              // For the guess and feedback history
+
+// Words the solver chooses from. Both lists must stay alive as long as the solver.
+struct SolverWords {
+    WordPlanes answers;              // Possible secret words
+    const char* guesses = nullptr;   // Allowed guesses back to back (as many letters each as the solver's word length)
+    size_t guessCount = 0;
+};
+
+// Best guess found so far by a hint search
+struct Hint {
+    std::string guess;        // Suggested guess (empty until the first result is in)
+    double bits = 0.0;        // Expected information of the guess in bits
+    size_t candidates = 0;    // Answers still possible with the feedback so far
+    float progress = 0.0f;    // Fraction of the guesses checked so far (0..1)
+    bool finished = false;    // True when every guess has been checked
+};
+
+// Suggests the guess with the highest expected information (entropy of its feedback patterns
+// over the answers that are still possible). Searches run on a work-stealing pool and never
+// block the caller: RequestHint() starts a search and CurrentHint() returns the best guess found
+// so far. The opening search starts as soon as the solver is created and its result is kept,
+// because the first guess is the same in every game. There is one solver per word length L, and
+// all of them share one pool so the game never runs more workers than there are cores.
+template <int L>
+class Solver {
+public:
+    Solver(const SolverWords& words, ThreadPool& pool);  // `pool` must outlive the solver
+    ~Solver();                                           // Cancels the searches and waits for their tasks
+
+    Solver(const Solver&) = delete;
+    Solver& operator=(const Solver&) = delete;
+
+    // Start looking for the best next guess (cancels the previous search)
+    void RequestHint(const std::vector<std::string>& guesses, const std::vector<Pattern<L>>& feedbacks);
+    void CancelHint();
+    Hint CurrentHint() const;
+
+private:
+    struct Search;
+
+    void Submit(std::function<void()> task);  // Run a task on the pool, counted in tasksQueued
+    std::shared_ptr<Search> StartSearch(const std::vector<std::string>& guesses, const std::vector<Pattern<L>>& feedbacks);
+    void FindCandidates(const std::shared_ptr<Search>& search);
+    void EvaluateGuesses(const std::shared_ptr<Search>& search, const char* words, size_t begin, size_t end);
+    void FinishChunk(const std::shared_ptr<Search>& search);
+
+    SolverWords words;
+    ThreadPool& pool;
+    std::shared_ptr<Search> openingSearch;  // Runs once, then serves every opening hint
+    std::shared_ptr<Search> currentSearch;  // Search shown by CurrentHint()
+    mutable std::mutex searchMutex;         // Guards currentSearch
+    std::mutex tasksMutex;                  // Guards tasksQueued
+    std::condition_variable tasksDone;      // Signalled when tasksQueued drops to 0
+    size_t tasksQueued = 0;                 // Tasks of this solver still queued or running on the pool
+};
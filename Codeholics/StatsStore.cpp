@@ -0,0 +1,465 @@
+#include "StatsStore.h"
+#include <algorithm>  // For sorting the leaderboard
+#include <cstring>    // For memcpy, memcmp and strnlen
+#include <ctime>      // For the time of a game
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>     // For open()
+#include <unistd.h>    // For write(), fsync() and ftruncate()
+#endif
+
+static_assert(sizeof(StatsRecord) == 40, "StatsRecord is stored on disk");
+static_assert(sizeof(PlayerStats) == 104, "PlayerStats is stored on disk");
+static_assert(sizeof(StatsSummaryHeader) == 72, "StatsSummaryHeader is stored on disk");
+
+const size_t SECTION_ALIGNMENT = 64;  // Summary sections start on a cache line
+
+// FNV-1a hash, used for checksums and for the player table
+static uint64_t Fnv1a(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint32_t RecordChecksum(const StatsRecord& record) {
+    return (uint32_t)Fnv1a(&record, offsetof(StatsRecord, checksum));
+}
+
+static uint32_t HeaderChecksum(const StatsSummaryHeader& header) {
+    return (uint32_t)Fnv1a(&header, offsetof(StatsSummaryHeader, checksum));
+}
+
+// Copy a name into a zero-padded name field, cutting it off at MAX_PLAYER_NAME letters
+static void CopyName(char* field, const char* name) {
+    memset(field, 0, MAX_PLAYER_NAME + 1);
+    memcpy(field, name, strnlen(name, MAX_PLAYER_NAME));
+}
+
+// Leaderboard order: total score, then wins, then name
+static bool RanksBefore(const PlayerStats& a, const PlayerStats& b) {
+    if (a.totalScore != b.totalScore) return a.totalScore > b.totalScore;
+    if (a.wins != b.wins) return a.wins > b.wins;
+    return strncmp(a.name, b.name, MAX_PLAYER_NAME + 1) < 0;
+}
+
+static size_t AlignSection(size_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Files that are written in place: the log, and new summaries before they are renamed
+
+#ifdef _WIN32
+
+static intptr_t OpenWritable(const std::string& path, bool truncate) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return file == INVALID_HANDLE_VALUE ? -1 : (intptr_t)file;
+}
+
+static void CloseWritable(intptr_t file) {
+    CloseHandle((HANDLE)file);
+}
+
+static bool AppendBytes(intptr_t file, const void* data, size_t size) {
+    LARGE_INTEGER zero = {};
+    DWORD written = 0;
+    return SetFilePointerEx((HANDLE)file, zero, nullptr, FILE_END) && WriteFile((HANDLE)file, data, (DWORD)size, &written, nullptr) && written == size;
+}
+
+static bool SyncFile(intptr_t file) {
+    return FlushFileBuffers((HANDLE)file) != 0;
+}
+
+static bool TruncateFile(intptr_t file, uint64_t size) {
+    LARGE_INTEGER position;
+    position.QuadPart = (LONGLONG)size;
+    return SetFilePointerEx((HANDLE)file, position, nullptr, FILE_BEGIN) && SetEndOfFile((HANDLE)file);
+}
+
+// Replace `path` with `from` in one step
+static bool ReplaceFileWith(const std::string& from, const std::string& path) {
+    return MoveFileExA(from.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+static intptr_t OpenWritable(const std::string& path, bool truncate) {
+    return open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+}
+
+static void CloseWritable(intptr_t file) {
+    close((int)file);
+}
+
+static bool AppendBytes(intptr_t file, const void* data, size_t size) {
+    if (lseek((int)file, 0, SEEK_END) < 0) return false;
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = write((int)file, bytes, size);
+        if (written <= 0) return false;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool SyncFile(intptr_t file) {
+    return fsync((int)file) == 0;
+}
+
+static bool TruncateFile(intptr_t file, uint64_t size) {
+    return ftruncate((int)file, (off_t)size) == 0;
+}
+
+// Replace `path` with `from` in one step, and make the rename itself durable
+static bool ReplaceFileWith(const std::string& from, const std::string& path) {
+    if (rename(from.c_str(), path.c_str()) != 0) return false;
+    size_t slash = path.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int directoryFile = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (directoryFile >= 0) {
+        fsync(directoryFile);
+        close(directoryFile);
+    }
+    return true;
+}
+
+#endif
+
+// Write a whole file under a temporary name and rename it over `path`
+static bool WriteFileAtomically(const std::string& path, const void* data, size_t size, bool sync) {
+    const std::string temporaryPath = path + ".tmp";
+    intptr_t file = OpenWritable(temporaryPath, true);
+    if (file < 0) return false;
+    bool ok = AppendBytes(file, data, size) && (!sync || SyncFile(file));
+    CloseWritable(file);
+    return ok && ReplaceFileWith(temporaryPath, path);
+}
+
+StatsStore::~StatsStore() {
+    Close();
+}
+
+bool StatsStore::Open(const std::string& path, std::string& error) {
+    Close();
+    basePath = path;
+    recent.clear();
+    summaryGames = 0;
+    recentGames = 0;
+    newPlayers = 0;
+
+    // The summary is optional: there is none before the first compaction
+    uint64_t summaryGeneration = 0;
+    uint64_t replayFrom = sizeof(StatsLogHeader);
+    const std::string summaryPath = basePath + ".summary";
+    if (summaryFile.Open(summaryPath)) {
+        const StatsSummaryHeader* header = Summary();
+        const uint64_t size = summaryFile.Size();
+        bool valid = header != nullptr && header->checksum == HeaderChecksum(*header)
+            && (header->tableSize & (header->tableSize - 1)) == 0 && header->tableSize > header->playerCount
+            && header->playerOffset + (uint64_t)header->playerCount * sizeof(PlayerStats) <= size
+            && header->tableOffset + (uint64_t)header->tableSize * sizeof(uint32_t) <= size
+            && header->rankingOffset + (uint64_t)header->playerCount * sizeof(uint32_t) <= size;
+        if (!valid) {
+            error = summaryPath + " is damaged";
+            summaryFile.Close();
+            return false;
+        }
+        summaryGeneration = header->generation;
+        replayFrom = header->logOffset;
+        summaryGames = header->totalGames;
+    }
+    return OpenLog(summaryGeneration, replayFrom, error);
+}
+
+// Replay the records the summary does not have yet, or start a new log if they are all in it
+bool StatsStore::OpenLog(uint64_t summaryGeneration, uint64_t replayFrom, std::string& error) {
+    const std::string logPath = basePath + ".log";
+    MappedFile log;
+    StatsLogHeader header = {};
+    if (log.Open(logPath) && log.Size() >= sizeof(StatsLogHeader)) memcpy(&header, log.Data(), sizeof(header));
+
+    if (header.magic == 0 || header.generation < summaryGeneration) {
+        // No log yet (or one cut off while it was being created), or one that was already compacted
+        log.Close();
+        return StartLog(summaryGeneration, error);
+    }
+    if (header.magic != STATS_LOG_MAGIC || header.version != STATS_VERSION) {
+        error = logPath + " is not a statistics log";
+        return false;
+    }
+    if (header.generation > summaryGeneration || replayFrom > log.Size()) {
+        error = logPath + " does not belong to " + basePath + ".summary";
+        return false;
+    }
+
+    // Replay every complete record; the first one that is cut off or damaged ends the log
+    uint64_t offset = replayFrom;
+    while (offset + sizeof(StatsRecord) <= log.Size()) {
+        StatsRecord record;
+        memcpy(&record, log.Data() + offset, sizeof(record));
+        if (record.checksum != RecordChecksum(record)) break;
+        Apply(record);
+        recentGames++;
+        offset += sizeof(StatsRecord);
+    }
+    const uint64_t fileSize = log.Size();
+    log.Close();
+
+    logFile = OpenWritable(logPath, false);
+    if (logFile < 0) {
+        error = "Cannot open " + logPath;
+        return false;
+    }
+    if (offset < fileSize && (!TruncateFile(logFile, offset) || !SyncFile(logFile))) {  // Drop what a crash left behind
+        error = "Cannot repair " + logPath;
+        Close();
+        return false;
+    }
+    generation = summaryGeneration;
+    logSize = offset;
+    return true;
+}
+
+// Replace the log with an empty one of the given generation
+bool StatsStore::StartLog(uint64_t newGeneration, std::string& error) {
+    const std::string logPath = basePath + ".log";
+    if (logFile >= 0) CloseWritable(logFile);
+    logFile = -1;
+
+    StatsLogHeader header = {};
+    header.magic = STATS_LOG_MAGIC;
+    header.version = STATS_VERSION;
+    header.generation = newGeneration;
+    if (!WriteFileAtomically(logPath, &header, sizeof(header), true)) {
+        error = "Cannot write " + logPath;
+        return false;
+    }
+    logFile = OpenWritable(logPath, false);
+    if (logFile < 0) {
+        error = "Cannot open " + logPath;
+        return false;
+    }
+    generation = newGeneration;
+    logSize = sizeof(header);
+    return true;
+}
+
+void StatsStore::Close() {
+    if (logFile >= 0) CloseWritable(logFile);  // No compaction: the next Open replays the tail
+    logFile = -1;
+    summaryFile.Close();
+    recent.clear();
+    recentGames = 0;
+    newPlayers = 0;
+}
+
+bool StatsStore::Record(const GameResult& result, std::string& error) {
+    if (logFile < 0) {
+        error = "The statistics are not open";
+        return false;
+    }
+
+    StatsRecord record = {};
+    CopyName(record.player, result.player.c_str());
+    record.time = result.time != 0 ? result.time : (int64_t)time(nullptr);
+    record.score = result.score;
+    record.guesses = (uint8_t)result.guesses;
+    record.won = result.won ? 1 : 0;
+    record.wordLength = (uint8_t)result.wordLength;
+    record.boards = (uint8_t)result.boards;
+    record.absurdle = result.absurdle ? 1 : 0;
+    record.checksum = RecordChecksum(record);
+
+    if (!AppendBytes(logFile, &record, sizeof(record)) || (durable && !SyncFile(logFile))) {
+        TruncateFile(logFile, logSize);  // Never leave half a record in front of the next one
+        error = "Cannot write " + basePath + ".log";
+        return false;
+    }
+    logSize += sizeof(record);
+    Apply(record);
+    recentGames++;
+
+    if (recentGames >= std::max<uint64_t>(COMPACT_AFTER_RECORDS, PlayerCount() / 8)) return Compact(error);
+    return true;
+}
+
+// Add a game to its player's totals in `recent`
+void StatsStore::Apply(const StatsRecord& record) {
+    std::string name(record.player, strnlen(record.player, MAX_PLAYER_NAME + 1));
+    auto found = recent.find(name);
+    if (found == recent.end()) {
+        PlayerStats stats;
+        const PlayerStats* saved = FindInSummary(record.player);
+        if (saved != nullptr) stats = *saved;  // Continue from the summary
+        else {
+            memset(&stats, 0, sizeof(stats));
+            CopyName(stats.name, name.c_str());
+            newPlayers++;
+        }
+        found = recent.emplace(name, stats).first;
+    }
+
+    PlayerStats& stats = found->second;
+    stats.games++;
+    if (record.won) {
+        stats.wins++;
+        stats.currentStreak++;
+        stats.maxStreak = std::max(stats.maxStreak, stats.currentStreak);
+        stats.histogram[std::min<int>(record.guesses, STATS_HISTOGRAM_SIZE - 1)]++;
+    }
+    else {
+        stats.currentStreak = 0;
+        stats.histogram[0]++;
+    }
+    stats.totalScore += (uint64_t)std::max(0, record.score);
+    stats.lastPlayed = record.time;
+}
+
+bool StatsStore::Compact(std::string& error) {
+    if (logFile < 0) {
+        error = "The statistics are not open";
+        return false;
+    }
+
+    // Every player: the summary's, with the ones that played since replaced by their new totals
+    const StatsSummaryHeader* old = Summary();
+    const uint32_t oldCount = old ? old->playerCount : 0;
+    const PlayerStats* oldPlayers = old ? (const PlayerStats*)(summaryFile.Data() + old->playerOffset) : nullptr;
+    const size_t playerCount = oldCount + newPlayers;
+    uint32_t tableSize = 16;
+    while (tableSize < playerCount * 2) tableSize *= 2;  // At most half full, so probes stay short
+
+    StatsSummaryHeader header = {};
+    header.magic = STATS_SUMMARY_MAGIC;
+    header.version = STATS_VERSION;
+    header.generation = generation + 1;  // The log that follows this summary
+    header.logOffset = sizeof(StatsLogHeader);
+    header.totalGames = summaryGames + recentGames;
+    header.playerCount = (uint32_t)playerCount;
+    header.tableSize = tableSize;
+    header.playerOffset = AlignSection(sizeof(header));
+    header.tableOffset = AlignSection(header.playerOffset + playerCount * sizeof(PlayerStats));
+    header.rankingOffset = AlignSection(header.tableOffset + (size_t)tableSize * sizeof(uint32_t));
+    header.checksum = HeaderChecksum(header);
+
+    std::vector<uint8_t> file(header.rankingOffset + playerCount * sizeof(uint32_t), 0);
+    memcpy(file.data(), &header, sizeof(header));
+    PlayerStats* players = (PlayerStats*)(file.data() + header.playerOffset);
+    uint32_t* table = (uint32_t*)(file.data() + header.tableOffset);
+    uint32_t* ranking = (uint32_t*)(file.data() + header.rankingOffset);
+
+    // Players keep their index, so only the ones that played since the last compaction move
+    if (oldCount > 0) memcpy(players, oldPlayers, oldCount * sizeof(PlayerStats));
+    std::vector<uint8_t> changed(oldCount, 0);
+    std::vector<uint32_t> moved;  // Indices of changed and new players
+    moved.reserve(recent.size());
+    uint32_t count = oldCount;
+    for (const auto& entry : recent) {
+        const PlayerStats* saved = FindInSummary(entry.second.name);
+        const uint32_t index = saved ? (uint32_t)(saved - oldPlayers) : count++;  // New players go last
+        players[index] = entry.second;
+        if (saved) changed[index] = 1;
+        moved.push_back(index);
+    }
+
+    // Reuse the old hash table while it is big enough, then add the new players
+    uint32_t firstToHash = 0;
+    if (old && old->tableSize == tableSize) {
+        memcpy(table, summaryFile.Data() + old->tableOffset, (size_t)tableSize * sizeof(uint32_t));
+        firstToHash = oldCount;
+    }
+    for (uint32_t i = firstToHash; i < count; i++) {
+        uint64_t slot = Fnv1a(players[i].name, MAX_PLAYER_NAME + 1) & (tableSize - 1);
+        while (table[slot] != 0) slot = (slot + 1) & (tableSize - 1);
+        table[slot] = i + 1;
+    }
+
+    // The old ranking without the moved players is still in order; merge the moved ones back in
+    auto ranksBefore = [players](uint32_t a, uint32_t b) { return RanksBefore(players[a], players[b]); };
+    std::vector<uint32_t> kept;
+    kept.reserve(oldCount);
+    const uint32_t* oldRanking = old ? (const uint32_t*)(summaryFile.Data() + old->rankingOffset) : nullptr;
+    for (uint32_t i = 0; i < oldCount; i++) {
+        if (!changed[oldRanking[i]]) kept.push_back(oldRanking[i]);
+    }
+    std::sort(moved.begin(), moved.end(), ranksBefore);
+    std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(), ranking, ranksBefore);
+
+    // Publish the summary, then start the log generation it points to
+    const std::string summaryPath = basePath + ".summary";
+    summaryFile.Close();  // Windows cannot replace a mapped file
+    if (!WriteFileAtomically(summaryPath, file.data(), file.size(), durable)) {
+        summaryFile.Open(summaryPath);  // Keep the old summary
+        error = "Cannot write " + summaryPath;
+        return false;
+    }
+    summaryFile.Open(summaryPath);
+    recent.clear();
+    summaryGames = header.totalGames;
+    recentGames = 0;
+    newPlayers = 0;
+    return StartLog(header.generation, error);
+}
+
+const StatsSummaryHeader* StatsStore::Summary() const {
+    if (!summaryFile.IsOpen() || summaryFile.Size() < sizeof(StatsSummaryHeader)) return nullptr;
+    const StatsSummaryHeader* header = (const StatsSummaryHeader*)summaryFile.Data();
+    if (header->magic != STATS_SUMMARY_MAGIC || header->version != STATS_VERSION) return nullptr;
+    return header;
+}
+
+const PlayerStats* StatsStore::FindInSummary(const char* name) const {
+    const StatsSummaryHeader* header = Summary();
+    if (header == nullptr) return nullptr;
+
+    char key[MAX_PLAYER_NAME + 1];
+    CopyName(key, name);
+    const PlayerStats* players = (const PlayerStats*)(summaryFile.Data() + header->playerOffset);
+    const uint32_t* table = (const uint32_t*)(summaryFile.Data() + header->tableOffset);
+    for (uint64_t slot = Fnv1a(key, sizeof(key)) & (header->tableSize - 1);; slot = (slot + 1) & (header->tableSize - 1)) {
+        if (table[slot] == 0) return nullptr;
+        const PlayerStats& player = players[table[slot] - 1];
+        if (memcmp(player.name, key, sizeof(key)) == 0) return &player;
+    }
+}
+
+bool StatsStore::Find(const std::string& player, PlayerStats& stats) const {
+    auto found = recent.find(player.substr(0, MAX_PLAYER_NAME));
+    if (found != recent.end()) {
+        stats = found->second;
+        return true;
+    }
+    const PlayerStats* saved = FindInSummary(player.c_str());
+    if (saved == nullptr) return false;
+    stats = *saved;
+    return true;
+}
+
+void StatsStore::TopPlayers(size_t count, std::vector<PlayerStats>& top) const {
+    top.clear();
+
+    // The summary is already sorted; skip players whose totals changed since
+    if (const StatsSummaryHeader* header = Summary()) {
+        const PlayerStats* players = (const PlayerStats*)(summaryFile.Data() + header->playerOffset);
+        const uint32_t* ranking = (const uint32_t*)(summaryFile.Data() + header->rankingOffset);
+        for (uint32_t i = 0; i < header->playerCount && top.size() < count; i++) {
+            const PlayerStats& player = players[ranking[i]];
+            if (recent.count(std::string(player.name, strnlen(player.name, MAX_PLAYER_NAME + 1))) == 0) top.push_back(player);
+        }
+    }
+
+    // Then merge in the players with newer totals
+    for (const auto& entry : recent) top.push_back(entry.second);
+    const size_t kept = std::min(count, top.size());
+    std::partial_sort(top.begin(), top.begin() + kept, top.end(), RanksBefore);
+    top.resize(kept);
+}
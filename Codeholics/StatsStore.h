@@ -0,0 +1,132 @@
+#pragma once
+#include "MappedFile.h"  // The summary is memory-mapped, never parsed
+#include <cstddef>       // For size_t
+#include <cstdint>       // For fixed-width integer types
+#include <string>        // For paths, names and error messages
+#include <unordered_map> // For the players changed since the last compaction
+#include <vector>        // For leaderboards
+
+// Statistics of every finished game, kept in two files next to each other:
+//
+//   <base>.log      append-only log: StatsLogHeader, then one StatsRecord per finished game
+//   <base>.summary  StatsSummaryHeader, PlayerStats of every player, a hash table of players
+//                   (uint32 index + 1, 0 = empty) and every player index sorted by total score
+//
+// Opening the store maps the summary and only replays the log records written after the last
+// compaction, so startup does not depend on how many games were ever played. The tail is
+// compacted once it holds COMPACT_AFTER_RECORDS records or an eighth of the player count,
+// whichever is larger, so rewriting the summary costs a bounded amount per game. Closing the
+// store does not compact, so quitting after a game stays quick. Records carry a
+// checksum; a record that was cut off by a crash is dropped when the log is opened. A new summary
+// is written to a temporary file and renamed over the old one, so it is either the old or the
+// new summary. Compaction then starts a new log generation: a log older than the summary was
+// already compacted and is dropped, so no game is counted twice whatever step a crash hits.
+// All numbers are little-endian.
+
+const uint32_t STATS_LOG_MAGIC = 0x4C534843;      // "CHSL"
+const uint32_t STATS_SUMMARY_MAGIC = 0x53534843;  // "CHSS"
+const uint32_t STATS_VERSION = 1;
+const int MAX_PLAYER_NAME = 15;                   // Longer names are cut off
+const int STATS_HISTOGRAM_SIZE = 14;              // [0] = lost, [n] = won in n guesses (up to 13 with 8 boards)
+const size_t COMPACT_AFTER_RECORDS = 4096;        // Smallest log tail that triggers a compaction
+
+struct StatsLogHeader {
+    uint32_t magic;       // STATS_LOG_MAGIC
+    uint32_t version;     // STATS_VERSION
+    uint64_t generation;  // Number of compactions before this log was started
+};
+
+// One finished game
+struct StatsRecord {
+    char player[MAX_PLAYER_NAME + 1];  // Zero-padded name
+    int64_t time;                      // When the game ended (seconds since 1970)
+    int32_t score;                     // Points won in the game
+    uint8_t guesses;                   // Guesses used
+    uint8_t won;                       // 1 if every board was solved
+    uint8_t wordLength;                // Variant of the game
+    uint8_t boards;
+    uint8_t absurdle;                  // 1 for the adversarial mode
+    uint8_t reserved[3];
+    uint32_t checksum;                 // FNV-1a of the bytes before it
+};
+
+// Totals of one player
+struct PlayerStats {
+    char name[MAX_PLAYER_NAME + 1];              // Zero-padded name
+    uint32_t games;                              // Games finished
+    uint32_t wins;                               // Games won
+    uint32_t currentStreak;                      // Wins in a row up to the last game
+    uint32_t maxStreak;                          // Longest run of wins
+    uint64_t totalScore;                         // Points of every game (the leaderboard order)
+    int64_t lastPlayed;                          // Time of the last game
+    uint32_t histogram[STATS_HISTOGRAM_SIZE];    // Games by guesses needed, [0] = lost
+};
+
+struct StatsSummaryHeader {
+    uint32_t magic;            // STATS_SUMMARY_MAGIC
+    uint32_t version;          // STATS_VERSION
+    uint64_t generation;       // Generation of the log that continues this summary
+    uint64_t logOffset;        // Where that log's records not in the summary start
+    uint64_t totalGames;       // Games in the summary
+    uint32_t playerCount;
+    uint32_t tableSize;        // Slots in the player hash table (a power of two)
+    uint64_t playerOffset;     // File offsets of each section
+    uint64_t tableOffset;
+    uint64_t rankingOffset;
+    uint32_t reserved;
+    uint32_t checksum;         // FNV-1a of the header bytes before it
+};
+
+// A finished game as the game reports it
+struct GameResult {
+    std::string player;
+    int wordLength = 5;
+    int boards = 1;
+    bool absurdle = false;
+    bool won = false;
+    int guesses = 0;     // Guesses used
+    int score = 0;       // Points won in the game
+    int64_t time = 0;    // 0 = now
+};
+
+// Persistent statistics and leaderboard
+class StatsStore {
+public:
+    StatsStore() = default;
+    ~StatsStore();
+
+    StatsStore(const StatsStore&) = delete;
+    StatsStore& operator=(const StatsStore&) = delete;
+
+    bool Open(const std::string& basePath, std::string& error);  // Map the summary and replay the log tail
+    void Close();                                                 // Safe to call when closed
+    bool IsOpen() const { return logFile >= 0; }
+
+    // Append a finished game. With `durable` the record is on disk when this returns.
+    bool Record(const GameResult& result, std::string& error);
+    bool Compact(std::string& error);  // Fold the log into a new summary and start a new log
+    void SetDurable(bool durable) { this->durable = durable; }
+
+    bool Find(const std::string& player, PlayerStats& stats) const;  // False if the player never finished a game
+    void TopPlayers(size_t count, std::vector<PlayerStats>& top) const;  // Highest total scores first
+    uint64_t TotalGames() const { return summaryGames + recentGames; }
+    size_t PlayerCount() const { return (Summary() ? Summary()->playerCount : 0) + newPlayers; }
+
+private:
+    const StatsSummaryHeader* Summary() const;
+    const PlayerStats* FindInSummary(const char* name) const;
+    void Apply(const StatsRecord& record);
+    bool OpenLog(uint64_t summaryGeneration, uint64_t replayFrom, std::string& error);
+    bool StartLog(uint64_t newGeneration, std::string& error);
+
+    std::string basePath;
+    MappedFile summaryFile;                                  // Empty until the first compaction
+    std::unordered_map<std::string, PlayerStats> recent;     // Players with games in the log tail
+    uint64_t summaryGames = 0;
+    uint64_t recentGames = 0;                                 // Records in the log tail
+    size_t newPlayers = 0;                                    // Players in `recent` that are not in the summary
+    uint64_t logSize = 0;                                     // Bytes of valid records in the log
+    uint64_t generation = 0;                                  // Of the open log
+    intptr_t logFile = -1;                                    // File descriptor (or HANDLE) of the log
+    bool durable = true;
+};
@@ -0,0 +1,81 @@
+#include "ThreadPool.h"
+#include "Profiler.h"  // For naming the workers in traces
+
+// Which pool and worker the current thread belongs to (nullptr for threads outside any pool)
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local unsigned currentWorker = 0;
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;  // hardware_concurrency() may not know the core count
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    // Keep work on the submitting worker's queue, spread work from other threads round-robin
+    unsigned index = (currentPool == this) ? currentWorker : nextQueue++ % (unsigned)queues.size();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);  // Pairs with the wait in WorkerLoop so no wake-up is lost
+        pendingTasks++;  // Counted before the push so the counter never drops below zero
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::TakeTask(unsigned index, std::function<void()>& task) {
+    const unsigned count = (unsigned)queues.size();
+    for (unsigned i = 0; i < count; i++) {
+        WorkerQueue& queue = *queues[(index + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (i == 0) {  // Newest task from our own queue (its data is most likely still in cache)
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {  // Oldest task from someone else's queue (usually the biggest piece of work)
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        pendingTasks--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+    PROFILE_THREAD_NAME("Pool worker");
+
+    std::function<void()> task;
+    while (true) {
+        if (TakeTask(index, task)) {
+            task();
+            task = nullptr;  // Release whatever the task captured before sleeping
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || pendingTasks > 0; });
+        if (stopping && pendingTasks == 0) return;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>              // For the shared counters and flags
+#include <condition_variable>  // For putting idle workers to sleep
+#include <deque>               // For each worker's task queue
+#include <functional>          // For std::function tasks
+#include <memory>              // For std::unique_ptr
+#include <mutex>               // For guarding the task queues
+#include <thread>              // For the worker threads
+#include <vector>              // For the lists of workers and threads
+
+// Work-stealing thread pool. Every worker has its own queue: it takes the newest task from its
+// own queue first and, when that is empty, steals the oldest task from another worker. Tasks
+// submitted from inside a task go to the current worker's queue, so a task that splits its work
+// keeps the pieces local until other workers run out of work.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount = 0);  // 0 = one worker per CPU core
+    ~ThreadPool();                                  // Finishes queued tasks, then joins the workers
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+    unsigned ThreadCount() const { return (unsigned)threads.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void WorkerLoop(unsigned index);
+    bool TakeTask(unsigned index, std::function<void()>& task);  // Own queue first, then steal
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // One queue per worker
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;                 // Guards sleeping and waking workers
+    std::condition_variable wakeUp;        // Signalled when a task is submitted
+    std::atomic<size_t> pendingTasks{ 0 }; // Tasks queued but not yet taken
+    std::atomic<unsigned> nextQueue{ 0 };  // Round-robin queue for tasks submitted from outside
+    bool stopping = false;                 // Set by the destructor (guarded by sleepMutex)
+};
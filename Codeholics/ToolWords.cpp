@@ -0,0 +1,21 @@
+#include "ToolWords.h"
+
+bool ToolWords::Load(const std::string& dictionaryPath, std::string& error) {
+    if (!dictionaryPath.empty()) {
+        if (!dictionary.Open(dictionaryPath, WORD_LENGTH, error)) return false;
+        game.answers = dictionary.Answers();
+        game.dictionary = &dictionary;
+        guesses = dictionary.Guess(0);
+        guessCount = dictionary.GuessCount();
+        return true;
+    }
+
+    builtInAnswers = PackWords<WORD_LENGTH>(BuiltInWords(WORD_LENGTH));
+    builtInGuesses.clear();
+    for (const std::string& word : BuiltInWords(WORD_LENGTH)) builtInGuesses += word;
+    game.answers = builtInAnswers.View();
+    game.dictionary = nullptr;  // Every guess is accepted
+    guesses = builtInGuesses.c_str();
+    guessCount = BuiltInWords(WORD_LENGTH).size();
+    return true;
+}
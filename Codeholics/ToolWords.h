@@ -0,0 +1,25 @@
+#pragma once
+#include "Dictionary.h"  // Words from a dictionary file
+#include "GameCore.h"    // For GameWords and the built-in word lists
+#include "Scoring.h"     // For PackedWords
+#include <cstddef>       // For size_t
+#include <string>        // For paths and error messages
+
+// Words the benchmark and the server play WORD_LENGTH-letter games with: a dictionary file if one
+// is given, otherwise the built-in word list. Must stay alive as long as the games using it.
+class ToolWords {
+public:
+    bool Load(const std::string& dictionaryPath, std::string& error);  // An empty path picks the built-in list
+
+    const GameWords& Game() const { return game; }
+    const char* Guesses() const { return guesses; }  // Allowed guesses back to back, WORD_LENGTH letters each
+    size_t GuessCount() const { return guessCount; }
+
+private:
+    Dictionary dictionary;
+    PackedWords builtInAnswers;   // The built-in list laid out for scoring
+    std::string builtInGuesses;   // The built-in list back to back
+    GameWords game;
+    const char* guesses = nullptr;
+    size_t guessCount = 0;
+};
@@ -1,245 +1,780 @@
 #include "raylib.h"  // Raylib library for graphics and input handling
+#include "Scoring.h" // Packed feedback patterns and guess scoring
+#include "Dictionary.h" // Memory-mapped word lists
+#include "Solver.h"  // Background hint search
+#include "GameCore.h" // Game rules without drawing or input
+#include "Absurdle.h" // Adversarial game mode
+#include "RenderCache.h" // Screens are only redrawn when they change
+#include "StatsStore.h" // Statistics and leaderboard of finished games
+#include "Profiler.h" // Frame timing, the F3 overlay and trace export
+#include "rlgl.h"    // For flushing draw calls in --render-check
+#include <algorithm> // For std::min and std::max
+#include <memory>    // For std::unique_ptr
 #include <string>    // For using std::string to handle text
 #include <vector>    // To use std::vector for dynamic arrays
 #include <ctime>     // For random number generation based on the system time
-#include <cstdlib>   // For srand() and rand() for randomization
+#include <cstdio>    // For printing the result of --build-dict
+#include <cstdlib>   // For getenv and free
 
 // Game Constants
 const int SCREEN_WIDTH = 800;   // Width of the game window in pixels
 const int SCREEN_HEIGHT = 600;  // Height of the game window in pixels
-const int MAX_GUESSES = 6;      // Maximum number of guesses allowed
-const int WORD_LENGTH = 5;      // Length of the secret word
+const int MENU_OPTION_COUNT = 8;  // Number of rows in the main menu
 
 // Colors for feedback
 Color CORRECT_COLOR = GREEN;   // Color for correct letters in the correct positions
 Color PRESENT_COLOR = YELLOW;  // Color for correct letters in wrong positions
 Color ABSENT_COLOR = GRAY;     // Color for absent letters
 
-// List of potential words for the secret word
-std::vector<std::string> wordList = { "CRANE", "PLANE", "BRAVE", "GRAPE", "SHINE", "BLEND", "DRIVE", "CHIME", "PANTS", "STONE", "STOVE", "PLAIN", "STAIN", "PHOTO", "PHONE", "MOUSE" };
+FramePacer framePacer;  // Lets idle screens wait for input instead of redrawing 60 times a second
 
-// Function to pick a random word from the list
-std::string GetRandomWord() {
-    srand(static_cast<unsigned int>(time(0)));  // Seed random number generator with the current time
-    return wordList[rand() % wordList.size()];  // Select and return a random word
+StatsStore statsStore;  // Every finished game, kept between runs in stats.log and stats.summary
+std::string playerName = "PLAYER";  // Whose statistics finished games count for (--player NAME)
+#ifdef CODEHOLICS_PROFILE
+bool showProfiler = false;  // F3 shows frame times and counters over every screen
+#endif
+
+Dictionary dictionaries[MAX_WORD_LENGTH + 1];  // Dictionary for each word length, loaded from DictionaryPath()
+PackedWords fallbackAnswers[MAX_WORD_LENGTH + 1];  // Built-in word lists laid out for scoring when there is no dictionary
+std::string fallbackGuesses[MAX_WORD_LENGTH + 1];  // Built-in word lists back to back for the solver
+
+// File the dictionary for a word length is loaded from (see BuildDictionary)
+std::string DictionaryPath(int length) {
+    return "words" + std::to_string(length) + ".cdict";
 }
 
-// Convert a character to uppercase
-char ToUpper(char c) {
-    if (c >= 'a' && c <= 'z') return c - 32;  // Convert lowercase letters to uppercase
-    return c;  // Return the character as it is if it's not a lowercase letter
+// Value of an environment variable, or "" if it is not set
+std::string EnvironmentVariable(const char* name) {
+#ifdef _MSC_VER
+    // MSVC rejects getenv() with SDL checks on
+    char* value = nullptr;
+    size_t length = 0;
+    std::string result;
+    if (_dupenv_s(&value, &length, name) == 0 && value != nullptr) result = value;
+    free(value);
+    return result;
+#else
+    const char* value = getenv(name);
+    return value != nullptr ? value : "";
+#endif
 }
 
-// Function to compare a guess with the answer and return feedback
-std::vector<int> CheckGuess(const std::string& guess, const std::string& word) {
-    std::vector<int> result(WORD_LENGTH, 0);  // Initialize the result vector with zeros (0 = absent, 1 = present, 2 = correct)
-    std::string UsedWord = word;  // Make a copy of the word to mark used letters
+// Load the dictionary files, falling back to the built-in word lists if they are missing or unusable
+void LoadDictionaries() {
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        for (const std::string& word : BuiltInWords(length)) fallbackGuesses[length] += word;
 
-    // First pass: Check for correct letters in the correct positions
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (guess[i] == UsedWord[i]) {
-            result[i] = 2;         // Mark as correct
-            UsedWord[i] = '*';     // Mark the letter as used in the word
+        std::string path = DictionaryPath(length);
+        std::string error;
+        if (!dictionaries[length].Open(path, length, error)) {
+            TraceLog(LOG_WARNING, "DICTIONARY: %s, using the built-in word list and accepting every guess", error.c_str());
         }
     }
 
-    // Second pass: Check for correct letters in the wrong positions
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (result[i] != 2) {  // Skip already matched letters
-            for (int j = 0; j < WORD_LENGTH; j++) {
-                if (guess[i] == UsedWord[j]) {
-                    result[i] = 1;  // Mark as present but misplaced
-                    UsedWord[j] = '*';  // Mark this letter as used
-                    break;
-                }
-            }
-        }
+    // Lay out the built-in lists for scoring (PackWords needs the length at compile time)
+    fallbackAnswers[4] = PackWords<4>(BuiltInWords(4));
+    fallbackAnswers[5] = PackWords<5>(BuiltInWords(5));
+    fallbackAnswers[6] = PackWords<6>(BuiltInWords(6));
+    fallbackAnswers[7] = PackWords<7>(BuiltInWords(7));
+    fallbackAnswers[8] = PackWords<8>(BuiltInWords(8));
+}
+
+// Words a game is played with: the dictionary if it was loaded, otherwise the built-in list
+GameWords GetGameWords(int length) {
+    GameWords words;
+    if (dictionaries[length].IsLoaded()) {
+        words.answers = dictionaries[length].Answers();
+        words.dictionary = &dictionaries[length];
+    }
+    else {
+        words.answers = fallbackAnswers[length].View();  // Every guess is accepted without a dictionary
     }
+    return words;
+}
+
+// Words the hint solver picks from
+SolverWords GetSolverWords(int length) {
+    SolverWords words;
+    if (dictionaries[length].IsLoaded()) {
+        words.answers = dictionaries[length].Answers();
+        words.guesses = dictionaries[length].Guess(0);
+        words.guessCount = dictionaries[length].GuessCount();
+    }
+    else {
+        words.answers = fallbackAnswers[length].View();
+        words.guesses = fallbackGuesses[length].c_str();
+        words.guessCount = BuiltInWords(length).size();
+    }
+    return words;
+}
+
+// Workers shared by the hint solvers of every word length
+ThreadPool& GetSolverPool() {
+    static ThreadPool pool;  // One worker per core
+    return pool;
+}
 
-    return result;  // Return the feedback array
+// Hint solver for L-letter words, started the first time it is needed (it begins searching for the opening guess at once)
+template <int L>
+Solver<L>& GetSolver() {
+    ThreadPool& pool = GetSolverPool();  // Created before the solver so it is destroyed after it
+    static std::unique_ptr<Solver<L>> solver;
+    if (!solver) solver.reset(new Solver<L>(GetSolverWords(L), pool));
+    return *solver;
+}
+
+// Convert a character to uppercase
+char ToUpper(char c) {
+    if (c >= 'a' && c <= 'z') return c - 32;  // Convert lowercase letters to uppercase
+    return c;  // Return the character as it is if it's not a lowercase letter
 }
 
 // Display the main menu of the game
-void DisplayMainMenu(int selectedOption) {
-    const char* menuOptions[] = { "PLAY", "HOW TO PLAY", "ABOUT US", "EXIT" };  // Menu options
-    int totalOptions = 4;  // Total number of menu options
+void DisplayMainMenu(int selectedOption, bool absurdle, int wordLength, int boards) {
+    const char* menuOptions[] = { "PLAY", absurdle ? "MODE: < ABSURDLE >" : "MODE: < CLASSIC >", TextFormat("WORD LENGTH: < %d >", wordLength),
+        absurdle ? "BOARDS: 1" : TextFormat("BOARDS: < %d >", boards), "HOW TO PLAY", "STATISTICS", "ABOUT US", "EXIT" };  // Menu options
+    int totalOptions = MENU_OPTION_COUNT;  // Total number of menu options
 
     ClearBackground(LIGHTGRAY);  // Clear screen and set background to white9
-    DrawText("WORDLE GAME MENU", SCREEN_WIDTH / 2 - MeasureText("WORDLE GAME MENU", 30) / 2, 50, 30, BLACK);  // Draw title
+    DrawScreenText("WORDLE GAME MENU", SCREEN_WIDTH / 2 - MeasureText("WORDLE GAME MENU", 30) / 2, 50, 30, BLACK);  // Draw title
 
     // Draw each menu option with highlighting for the selected one
     for (int i = 0; i < totalOptions; i++) {
         Color textColor = (i == selectedOption) ? GREEN : DARKGRAY;  // Highlight selected option
-        DrawText(menuOptions[i], SCREEN_WIDTH / 2 - MeasureText(menuOptions[i], 20) / 2, 150 + i * 50, 20, textColor);  // Draw the option
+        DrawScreenText(menuOptions[i], SCREEN_WIDTH / 2 - MeasureText(menuOptions[i], 20) / 2, 150 + i * 50, 20, textColor);  // Draw the option
     }
 }
 
 // Display instructions for how to play the game
 void DisplayHowToPlay() {
     ClearBackground(RAYWHITE);  // Clear screen and set background to white
-    DrawText("HOW TO PLAY", SCREEN_WIDTH / 2 - MeasureText("HOW TO PLAY", 30) / 2, 50, 30, BLACK);  // Title
+    DrawScreenText("HOW TO PLAY", SCREEN_WIDTH / 2 - MeasureText("HOW TO PLAY", 30) / 2, 50, 30, BLACK);  // Title
     // Instructions for the player
-    DrawText("1. Guess the secret 5-letter word in 6 attempts.", 50, 150, 20, DARKGRAY);
-    DrawText("2. Each guess must be a valid word.", 50, 180, 20, DARKGRAY);
-    DrawText("3. Green light is a correct letter", 50, 210, 20, DARKGRAY);
-    DrawText("4. Yellow light is a correct letter, but not in the correct place", 50, 210, 20, DARKGRAY);
-    DrawText("Press ESC to return to the menu.", 50, 270, 20, DARKGRAY);  // Navigation hint
+    DrawScreenText("1. Guess the secret word in 6 attempts, one more per extra board.", 50, 150, 20, DARKGRAY);
+    DrawScreenText("2. Each guess must be a valid word.", 50, 180, 20, DARKGRAY);
+    DrawScreenText("3. Green light is a correct letter", 50, 210, 20, DARKGRAY);
+    DrawScreenText("4. Yellow light is a correct letter, but not in the correct place", 50, 240, 20, DARKGRAY);
+    DrawScreenText("5. Press TAB during a game to get a hint.", 50, 270, 20, DARKGRAY);
+    DrawScreenText("6. Pick 4 to 8 letters and 2, 4 or 8 boards in the menu for a bigger", 50, 300, 20, DARKGRAY);
+    DrawScreenText("   challenge: every guess is played on all boards at once.", 50, 330, 20, DARKGRAY);
+    DrawScreenText("7. In ABSURDLE mode the word is not picked until it has to be: every", 50, 360, 20, DARKGRAY);
+    DrawScreenText("   guess gets the feedback that leaves the most words. 8 attempts.", 50, 390, 20, DARKGRAY);
+    DrawScreenText("Press ESC to return to the menu.", 50, 420, 20, DARKGRAY);  // Navigation hint
 }
 
 // Display information about the creators of the game
 void DisplayAboutUs() {
     ClearBackground(RAYWHITE);  // Clear screen and set background to white
-    DrawText("ABOUT US", SCREEN_WIDTH / 2 - MeasureText("ABOUT US", 30) / 2, 50, 30, BLACK);  // Title
+    DrawScreenText("ABOUT US", SCREEN_WIDTH / 2 - MeasureText("ABOUT US", 30) / 2, 50, 30, BLACK);  // Title
     // Description of the game and creator
-    DrawText("This Wordle-like game was created using raylib.", 50, 150, 20, DARKGRAY);
-    DrawText("We are still beginners, but we hope you like our mini game ", 50, 180, 20, DARKGRAY);
-    DrawText("Creators of the game: ", 50, 210, 20, DARKGRAY);
-    DrawText("1. Borimir Kirov (Scrum Trainer)", 50, 240, 20, DARKGRAY);
-    DrawText("2. Mila Lazarova (Designer)", 50, 270, 20, DARKGRAY);
-    DrawText("3. Aleksandar Georgiev (Back-End Developer)", 50, 300, 20, DARKGRAY);
-    DrawText("4. Dimitar Dimitrov (Back-End Developer)", 50, 330, 20, DARKGRAY);
-    DrawText("Press ESC to return to the menu.", 50, 360, 20, DARKGRAY);
-}
-
-// Function to handle the gameplay logic
-void RunGame() {
-    std::string answer = GetRandomWord();  // Select a random word as the answer
-    std::vector<std::string> guesses;  // Store player guesses
-    std::vector<std::vector<int>> feedbacks;  // Store feedback for each guess
-    std::string currentGuess = "";  // The current guess being typed by the player
-    int score = 0;  // Player's score
-    bool gameOver = false;  // Flag indicating if the game is over
-    bool gameWon = false;  // Flag indicating if the player has won
+    DrawScreenText("This Wordle-like game was created using raylib.", 50, 150, 20, DARKGRAY);
+    DrawScreenText("We are still beginners, but we hope you like our mini game ", 50, 180, 20, DARKGRAY);
+    DrawScreenText("Creators of the game: ", 50, 210, 20, DARKGRAY);
+    DrawScreenText("1. Borimir Kirov (Scrum Trainer)", 50, 240, 20, DARKGRAY);
+    DrawScreenText("2. Mila Lazarova (Designer)", 50, 270, 20, DARKGRAY);
+    DrawScreenText("3. Aleksandar Georgiev (Back-End Developer)", 50, 300, 20, DARKGRAY);
+    DrawScreenText("4. Dimitar Dimitrov (Back-End Developer)", 50, 330, 20, DARKGRAY);
+    DrawScreenText("Press ESC to return to the menu.", 50, 360, 20, DARKGRAY);
+}
+
+// Display the player's statistics and the leaderboard
+void DisplayStats(bool available, const PlayerStats& stats, const std::vector<PlayerStats>& top) {
+    ClearBackground(RAYWHITE);  // Clear screen and set background to white
+    DrawScreenText("STATISTICS", SCREEN_WIDTH / 2 - MeasureText("STATISTICS", 30) / 2, 50, 30, BLACK);  // Title
+    if (!available) {
+        DrawScreenText("Statistics cannot be saved on this computer.", 50, 150, 20, DARKGRAY);
+        DrawScreenText("Press ESC to return to the menu.", 50, 180, 20, DARKGRAY);
+        return;
+    }
+
+    // Totals of the player
+    const int winPercent = stats.games > 0 ? (int)(100ull * stats.wins / stats.games) : 0;
+    DrawScreenText(TextFormat("Player: %s", playerName.c_str()), 50, 110, 20, BLACK);
+    DrawScreenText(TextFormat("Games: %u   Won: %d%%   Streak: %u   Best streak: %u", stats.games, winPercent, stats.currentStreak, stats.maxStreak), 50, 140, 20, DARKGRAY);
+    DrawScreenText(TextFormat("Total score: %llu", (unsigned long long)stats.totalScore), 50, 170, 20, BLUE);
+
+    // Games by guesses needed, up to the most guesses any win took (at least 6)
+    int rows = 6;
+    for (int i = 7; i < STATS_HISTOGRAM_SIZE; i++) {
+        if (stats.histogram[i] > 0) rows = i;
+    }
+    uint32_t largest = 1;
+    for (int i = 0; i <= rows; i++) largest = std::max(largest, stats.histogram[i]);
+    DrawScreenText("GUESSES", 50, 210, 20, BLACK);
+    for (int i = 0; i <= rows; i++) {
+        const int row = (i == 0) ? rows : i - 1;  // Lost games go last
+        const int y = 240 + row * 22;
+        const int width = 20 + (int)(200ull * stats.histogram[i] / largest);
+        DrawScreenText(i == 0 ? "X" : TextFormat("%d", i), 50, y, 18, DARKGRAY);
+        DrawScreenRectangle(80, y, width, 18, i == 0 ? ABSENT_COLOR : CORRECT_COLOR);
+        DrawScreenText(TextFormat("%u", stats.histogram[i]), 84, y, 18, WHITE);
+    }
+
+    // Highest total scores of every player
+    DrawScreenText("LEADERBOARD", 450, 210, 20, BLACK);
+    for (size_t i = 0; i < top.size(); i++) {
+        const Color color = (playerName.compare(0, MAX_PLAYER_NAME, top[i].name) == 0) ? DARKGREEN : DARKGRAY;  // Highlight the player
+        DrawScreenText(TextFormat("%d. %s", (int)i + 1, top[i].name), 450, 240 + (int)i * 30, 20, color);
+        DrawScreenText(TextFormat("%llu", (unsigned long long)top[i].totalScore), 680, 240 + (int)i * 30, 20, color);
+    }
+    DrawScreenText("Press ESC to return to the menu.", 50, 560, 20, DARKGRAY);
+}
+
+// Where the boards of a game are drawn
+struct BoardLayout {
+    int cellStep;             // Distance between neighbouring cells
+    int cellSize;             // Width and height of a cell
+    int fontSize;             // Size of the letters in the cells
+    int boardX[MAX_BOARDS];   // Top-left corner of each board
+    int boardY[MAX_BOARDS];
+    int hintX;                // Where the hint is shown
+    int hintY;
+};
+
+// Fit the boards of a game on the screen. The classic game keeps its 60-pixel cells with the hint
+// to the right; several boards are laid out in rows of up to four below the messages.
+BoardLayout MakeBoardLayout(int wordLength, int boards, int guessRows) {
+    BoardLayout layout;
+    if (boards == 1) {
+        layout.cellStep = std::min(60, std::min(370 / wordLength, 440 / guessRows));
+        layout.boardX[0] = 50;
+        layout.boardY[0] = 150;
+        layout.hintX = 50 + wordLength * layout.cellStep + 70;
+        layout.hintY = 150;
+    }
+    else {
+        int columns = std::min(boards, 4);  // Boards per row
+        int rows = (boards + columns - 1) / columns;  // Rows of boards
+        int boardWidth = (SCREEN_WIDTH - 40) / columns;
+        int boardHeight = (SCREEN_HEIGHT - 150) / rows;
+        layout.cellStep = std::min(60, std::min((boardWidth - 20) / wordLength, (boardHeight - 10) / guessRows));
+        for (int b = 0; b < boards; b++) {
+            layout.boardX[b] = 20 + (b % columns) * boardWidth + (boardWidth - wordLength * layout.cellStep) / 2;  // Center the board in its column
+            layout.boardY[b] = 145 + (b / columns) * boardHeight;
+        }
+        layout.hintX = 560;  // Top right, next to the title
+        layout.hintY = 10;
+    }
+    layout.cellSize = layout.cellStep * 5 / 6;
+    layout.fontSize = std::max(10, layout.cellStep / 3);
+    return layout;
+}
+
+// Draw one cell with a letter in it
+void DrawCell(const BoardLayout& layout, int x, int y, char letter, Color cellColor, Color textColor) {
+    DrawScreenRectangle(x, y, layout.cellSize, layout.cellSize, cellColor);
+    DrawScreenText(LetterText(letter), x + layout.cellStep / 4, y + layout.cellStep / 4, layout.fontSize, textColor);
+}
+
+// What the hint area of the game screen shows
+struct HintView {
+    bool shown = false;  // Flag indicating if the player asked for a hint for this guess
+    int board = 0;       // Board the hint is for (the first unsolved one)
+    Hint hint;           // Best guess found so far
+    int percent = 0;     // Progress of the search as drawn
+};
+
+// Text on the game screen that is only measured when it changes
+struct GameTexts {
+    CachedText score;
+    CachedText totals;
+    CachedText answers;
+};
+
+// Draw the whole game screen. Only called when something on it changed (see RunGame).
+template <class Game>
+void DrawGame(const Game& game, const BoardLayout& layout, const HintView& hintView, const PlayerStats& playerStats, GameTexts& texts) {
+    const int L = Game::LENGTH;
+    const int B = Game::BOARDS;
+    ClearBackground(RAYWHITE);  // Set background color
+
+    // Draw the title of the game
+    DrawScreenText("WORDLE", SCREEN_WIDTH / 2 - MeasureText("WORDLE", 40) / 2, 20, 40, BLACK);
+
+    // Draw the message based on the game state
+    if (!game.IsOver()) {
+        PROFILE_SCOPE("Draw messages");
+        DrawScreenText(TextFormat("Type a %d-letter word and press ENTER to guess.", L), 20, 80, 20, DARKGRAY);
+        if (game.IsNotInWordList()) DrawScreenText("Not in word list!", 20, 110, 20, RED);  // Explain why ENTER did nothing
+        if (!game.ChecksWords()) DrawScreenText(TextFormat("No words%d.cdict: every guess is accepted.", L), 20, 110, 20, ORANGE);
+
+        // Draw the best hint found so far, or how to ask for one
+        if (hintView.shown) {
+            const Hint& hint = hintView.hint;
+            const char* guess = hint.guess.empty() ? "..." : hint.guess.c_str();
+            DrawScreenText(B == 1 ? TextFormat("HINT: %s", guess) : TextFormat("HINT (board %d): %s", hintView.board + 1, guess), layout.hintX, layout.hintY, 20, DARKBLUE);
+            DrawScreenText(TextFormat("%.2f bits, %d words left", hint.bits, (int)hint.candidates), layout.hintX, layout.hintY + 22, 20, DARKGRAY);
+            if (!hint.finished) DrawScreenText(TextFormat("Searching... %d%%", hintView.percent), layout.hintX, layout.hintY + 44, 20, DARKGRAY);
+        }
+        else {
+            DrawScreenText("Press TAB for a hint.", layout.hintX, layout.hintY, 20, GRAY);
+        }
+    }
+    else {
+        PROFILE_SCOPE("Draw messages");
+        DrawScreenText(game.IsWon() ? "YOU WIN! Press R to restart." : "GAME OVER! Press R to restart.", 20, 80, 20, game.IsWon() ? GREEN : RED);
+
+        // Show the correct words
+        char answers[MAX_BOARDS * (MAX_WORD_LENGTH + 1)];
+        char* end = answers;
+        for (int b = 0; b < B; b++) {
+            if (b > 0) *end++ = ' ';
+            for (int i = 0; i < L; i++) *end++ = game.Answer(b)[i];
+        }
+        *end = '\0';
+        const char* answerText = TextFormat(B == 1 ? "The word was: %s" : "The words were: %s", answers);
+        texts.answers.Set(answerText, 20, SCREEN_WIDTH - 40);  // Eight long words need a smaller font
+        DrawScreenText(texts.answers.Text(), 20, 110, texts.answers.FontSize(), DARKGRAY);
+
+        texts.score.Set(TextFormat("Score: %d", game.Score()), 20);
+        DrawScreenText(texts.score.Text(), SCREEN_WIDTH - texts.score.Width() - 10, 10, 20, BLUE); // Display score
+        if (playerStats.games > 0) {  // Totals of every game the player finished, this one included
+            texts.totals.Set(TextFormat("Total: %llu  Streak: %u", (unsigned long long)playerStats.totalScore, playerStats.currentStreak), 20);
+            DrawScreenText(texts.totals.Text(), SCREEN_WIDTH - texts.totals.Width() - 10, 35, 20, DARKBLUE);
+        }
+    }
+
+    for (int b = 0; b < B; b++) {
+        PROFILE_SCOPE("Draw board");
+        const int x = layout.boardX[b];
+        const int y = layout.boardY[b];
+        const int rows = game.SolvedAt(b) ? game.SolvedAt(b) : game.GuessCount();  // A solved board stops at its winning guess
+
+        // Draw each guess with feedback colors
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < L; j++) {
+                int feedback = PatternFeedback(game.Feedback(i, b), j);  // Feedback for the current letter
+                Color cellColor = (feedback == FEEDBACK_CORRECT) ? CORRECT_COLOR : (feedback == FEEDBACK_PRESENT) ? PRESENT_COLOR : ABSENT_COLOR; // Determine color
+                DrawCell(layout, x + j * layout.cellStep, y + i * layout.cellStep, game.Guess(i)[j], cellColor, WHITE);
+            }
+        }
+
+        // Draw the current guess being typed by the player
+        if (game.SolvedAt(b) == 0) {
+            for (int j = 0; j < game.CurrentLength(); j++) {
+                DrawCell(layout, x + j * layout.cellStep, y + rows * layout.cellStep, game.CurrentGuess()[j], LIGHTGRAY, BLACK);
+            }
+        }
+    }
+}
+
+#ifdef CODEHOLICS_PROFILE
+// Draw frame-time percentiles and the counters of the last frame over the screen (F3)
+void DrawProfilerOverlay() {
+    ProfileFrameReport report;
+    GetProfileFrameReport(report);
+    const int height = 70 + report.counterCount * 18;
+    DrawRectangle(10, 10, 330, height, Fade(BLACK, 0.75f));
+    DrawText(TextFormat("FRAME (%d): p50 %.2f  p95 %.2f  p99 %.2f ms", report.frames, report.p50, report.p95, report.p99), 18, 16, 10, WHITE);
+    DrawText(TextFormat("max %.2f ms, %.0f FPS", report.max, report.fps), 18, 32, 10, WHITE);
+    for (int c = 0; c < report.counterCount; c++) {
+        DrawText(TextFormat("%s: %llu", report.counterNames[c], (unsigned long long)report.counterValues[c]), 18, 50 + c * 18, 10, YELLOW);
+    }
+    DrawText("F3: hide   F4: save profile.json", 18, 50 + report.counterCount * 18 + 4, 10, LIGHTGRAY);
+}
+#endif
+
+// Rebuild a cached screen if it changed, then show it. While the screen is idle the frame waits
+// for the next input event instead of running again right away.
+template <class DrawFunction>
+void ShowScreen(CachedScreen& screen, bool idle, DrawFunction draw) {
+    if (screen.IsDirty()) {
+        PROFILE_SCOPE("Rebuild screen");
+        PROFILE_COUNT("screen rebuilds", 1);
+        screen.BeginRebuild();
+        draw();
+        screen.EndRebuild();
+    }
+    BeginDrawing();
+    screen.Draw();
+#ifdef CODEHOLICS_PROFILE
+    if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;
+    if (IsKeyPressed(KEY_F4)) {
+        std::string error;
+        if (ExportChromeTrace("profile.json", error)) TraceLog(LOG_INFO, "PROFILE: wrote profile.json");
+        else TraceLog(LOG_WARNING, "PROFILE: %s", error.c_str());
+    }
+    if (showProfiler) {
+        DrawProfilerOverlay();  // Drawn every frame on top of the cached screen
+        idle = false;  // Keep the numbers moving
+    }
+#endif
+    PROFILE_FRAME_END();  // Presenting and waiting for input are not part of the frame's work
+    framePacer.SetIdle(idle);
+    EndDrawing();
+    PROFILE_FRAME_BEGIN();
+    framePacer.CountFrame();
+}
+
+// Save a finished game in the statistics. Returns the player's totals with it.
+template <class Game>
+PlayerStats RecordGame(const Game& game, int scoreAtStart) {
+    PlayerStats stats = {};
+    if (!statsStore.IsOpen()) return stats;
+
+    GameResult result;
+    result.player = playerName;
+    result.wordLength = Game::LENGTH;
+    result.boards = Game::BOARDS;
+    result.absurdle = Game::ADVERSARIAL;
+    result.won = game.IsWon();
+    result.guesses = game.GuessCount();
+    result.score = game.Score() - scoreAtStart;
+    std::string error;
+    if (!statsStore.Record(result, error)) TraceLog(LOG_WARNING, "STATS: %s", error.c_str());
+    statsStore.Find(playerName, stats);
+    return stats;
+}
+
+// Function to handle the gameplay logic. Game is a GameCore<L, B> or an AbsurdleCore<L>.
+template <class Game>
+void RunGame(Game& game) {
+    const int L = Game::LENGTH;  // Letters per word
+    const int B = Game::BOARDS;  // Boards on the screen
+    Solver<L>& solver = GetSolver<L>();  // Hints for this word length
+    const BoardLayout layout = MakeBoardLayout(L, B, Game::GUESSES);
+    HintView hintView;  // Hint as it is drawn
+    std::vector<std::string> hintGuesses;  // History of the hint board, handed to the solver
+    std::vector<Pattern<L>> hintFeedbacks;
+    CachedScreen screen;  // The game screen, redrawn only when the game or the hint changes
+    GameTexts texts;
+    PlayerStats playerStats = {};  // Totals shown when the game is over
+    int scoreAtStart = game.Score();  // The score is kept between games, so a game's points are the difference
+    bool recorded = false;  // Flag indicating if the finished game is in the statistics
+    const int framesBefore = framePacer.Frames();
 
     while (!WindowShouldClose()) {  // Game loop runs until the window is closed
         if (IsKeyPressed(KEY_ESCAPE)) break;  // Exit the game to the menu if ESC is pressed
+        while (GetKeyPressed() != 0) screen.Invalidate();  // Every key the game reacts to changes the screen
 
-        if (!gameOver) {
+        if (!game.IsOver()) {
             // Handle user input
-                
-            if (IsKeyPressed(KEY_BACKSPACE) && !currentGuess.empty()) {
-                currentGuess.pop_back();  // Remove the last character if BACKSPACE is pressed
+            PROFILE_SCOPE("Input");
+            if (IsKeyPressed(KEY_BACKSPACE)) {
+                game.Backspace();  // Remove the last character if BACKSPACE is pressed
+            }
+            else if (IsKeyPressed(KEY_TAB)) {
+                hintView.board = 0;
+                while (game.SolvedAt(hintView.board) != 0) hintView.board++;  // The game is not over, so one board is unsolved
+                game.History(hintView.board, hintGuesses, hintFeedbacks);
+                solver.RequestHint(hintGuesses, hintFeedbacks);  // Start searching in the background
+                hintView.shown = true;  // Show the hint as it improves
+                hintView.hint = Hint();
             }
-            else if (IsKeyPressed(KEY_ENTER) && currentGuess.length() == WORD_LENGTH) {
+            else if (IsKeyPressed(KEY_ENTER)) {
                 // Submit the guess if ENTER is pressed and the guess is valid
-                std::vector<int> feedback = CheckGuess(currentGuess, answer);  // Get feedback for the guess
-                feedbacks.push_back(feedback);  // Store feedback
-                guesses.push_back(currentGuess);  // Store the guess
-
-                // Check if the guess is correct
-                if (currentGuess == answer) {
-                    gameOver = true;  // End the game
-                    gameWon = true;  // Player wins
-                    score += 100;  // Add points for winning
+                if (game.Submit() == GuessResult::Accepted) {
+                    solver.CancelHint();  // The hint was for the previous guess
+                    hintView.shown = false;  // Hide the old hint
                 }
-                else if (guesses.size() >= MAX_GUESSES) {
-                    gameOver = true;  // End the game if the maximum guesses are reached
-                }
-                currentGuess = "";  // Reset current guess
             }
             else {
                 // Add letters to the current guess
                 for (int key = KEY_A; key <= KEY_Z; key++) {
-                    if (IsKeyPressed(key) && currentGuess.length() < WORD_LENGTH) {
-                        currentGuess += ToUpper((char)(key - KEY_A + 'A'));  // Convert and add the letter
+                    if (IsKeyPressed(key)) {
+                        game.TypeLetter(ToUpper((char)(key - KEY_A + 'A')));  // Convert and add the letter
                     }
                 }
+                PROFILE_COUNT("keys polled", KEY_Z - KEY_A + 1);
             }
         }
         else {
             // Restart the game if it's over and 'R' is pressed
             if (IsKeyPressed(KEY_R)) {
-                answer = GetRandomWord();  // Select a new word
-                guesses.clear();  // Clear guesses
-                feedbacks.clear();  // Clear feedbacks
-                currentGuess = "";  // Reset current guess
-                gameOver = false;  // Reset game over flag
-                gameWon = false;  // Reset game won flag
+                PROFILE_SCOPE("New game");
+                game.NewGame();  // Select new words (or make every word possible again) and clear the boards
+                solver.CancelHint();  // Stop any hint search for the old game
+                hintView.shown = false;  // Hide the old hint
+                scoreAtStart = game.Score();
+                recorded = false;
+            }
+        }
+
+        // Save the game as soon as it is over, so leaving with ESC keeps it
+        if (game.IsOver() && !recorded) {
+            PROFILE_SCOPE("Save game");
+            playerStats = RecordGame(game, scoreAtStart);
+            recorded = true;
+        }
+
+        // A running hint search changes the screen without input, so check it every frame
+        bool searching = false;
+        if (hintView.shown && !game.IsOver()) {
+            PROFILE_SCOPE("Update hint");
+            Hint hint = solver.CurrentHint();
+            int percent = (int)(hint.progress * 100);
+            if (hint.guess != hintView.hint.guess || hint.candidates != hintView.hint.candidates || hint.finished != hintView.hint.finished || percent != hintView.percent) {
+                hintView.hint = hint;
+                hintView.percent = percent;
+                screen.Invalidate();
             }
+            searching = !hint.finished;
         }
 
         // Drawing the game
-        BeginDrawing();
-        ClearBackground(RAYWHITE);  // Set background color
+        ShowScreen(screen, !searching, [&]() {
+            PROFILE_SCOPE("Draw game");
+            DrawGame(game, layout, hintView, playerStats, texts);
+        });
+    }
 
-        // Draw the title of the game
-        DrawText("WORDLE", SCREEN_WIDTH / 2 - MeasureText("WORDLE", 40) / 2, 20, 40, BLACK);
+    solver.CancelHint();  // Stop searching when the player leaves the game
+    TraceLog(LOG_INFO, "RENDER: game screen drawn %d times in %d frames", screen.Rebuilds(), framePacer.Frames() - framesBefore);
+}
 
-        // Draw the message based on the game state
-        if (!gameOver) {
-            DrawText("Type a 5-letter word and press ENTER to guess.", 20, 80, 20, DARKGRAY);
-        }
-        else {
-            DrawText(gameWon ? "YOU WIN! Press R to restart." : "GAME OVER! Press R to restart.", 20, 80, 20, gameWon ? GREEN : RED);
-            DrawText(TextFormat("The word was: %s", answer.c_str()), 20, 110, 20, DARKGRAY); // Show the correct word
-            DrawText(TextFormat("Score: %d", score), SCREEN_WIDTH - MeasureText(TextFormat("Score: %d", score), 20) - 10, 10, 20, BLUE); // Display score
-        }
+// Play a game with B boards of L-letter words
+template <int L, int B>
+void PlayBoards() {
+    GameCore<L, B> game(GetGameWords(L), static_cast<uint32_t>(time(0)));  // Rules, answers and score of the game
+    RunGame(game);
+}
 
-        // Draw each guess with feedback colors
-        for (int i = 0; i < guesses.size(); i++) {
-            for (int j = 0; j < WORD_LENGTH; j++) {
-                int feedback = feedbacks[i][j];  // Feedback for the current letter
-                Color cellColor = (feedback == 2) ? CORRECT_COLOR : (feedback == 1) ? PRESENT_COLOR : ABSENT_COLOR; // Determine color
+// Start a game for the chosen mode and number of boards (every combination is its own RunGame)
+template <int L>
+void PlayLength(bool absurdle, int boards) {
+    if (absurdle) {
+        AbsurdleCore<L> game(GetGameWords(L));  // Sized for the answer list once, then never allocates
+        RunGame(game);
+        return;
+    }
+    switch (boards) {
+    case 1: PlayBoards<L, 1>(); break;
+    case 2: PlayBoards<L, 2>(); break;
+    case 4: PlayBoards<L, 4>(); break;
+    case 8: PlayBoards<L, 8>(); break;
+    }
+}
 
-                // Draw a rectangle for each letter, colored based on feedback
-                DrawRectangle(50 + j * 60, 150 + i * 60, 50, 50, cellColor);
-                // Draw the letter inside the rectangle
-                DrawText(std::string(1, guesses[i][j]).c_str(), 65 + j * 60, 165 + i * 60, 20, WHITE);
-            }
-        }
+// Start a game for the chosen mode, word length and number of boards
+void PlayVariant(bool absurdle, int wordLength, int boards) {
+    switch (wordLength) {
+    case 4: PlayLength<4>(absurdle, boards); break;
+    case 5: PlayLength<5>(absurdle, boards); break;
+    case 6: PlayLength<6>(absurdle, boards); break;
+    case 7: PlayLength<7>(absurdle, boards); break;
+    case 8: PlayLength<8>(absurdle, boards); break;
+    }
+}
 
-        // Draw the current guess being typed by the player
-        for (int j = 0; j < currentGuess.size(); j++) {
-            DrawRectangle(50 + j * 60, 150 + guesses.size() * 60, 50, 50, LIGHTGRAY);  // Draw light gray box
-            DrawText(std::string(1, currentGuess[j]).c_str(), 65 + j * 60, 165 + guesses.size() * 60, 20, BLACK); // Draw the letter
+// Draw a screen directly and through a CachedScreen and count the pixels that differ
+template <class DrawFunction>
+int CompareCachedScreen(const char* name, DrawFunction draw) {
+    CachedScreen screen;
+    screen.BeginRebuild();
+    draw();
+    screen.EndRebuild();
+
+    BeginDrawing();
+    draw();
+    rlDrawRenderBatchActive();  // Draw calls are batched, flush them before reading the pixels
+    Image direct = LoadImageFromScreen();
+    EndDrawing();
+
+    BeginDrawing();
+    ClearBackground(BLACK);  // Anything the cached screen does not cover would show up
+    screen.Draw();
+    rlDrawRenderBatchActive();
+    Image cached = LoadImageFromScreen();
+    EndDrawing();
+
+    int differences = 0;
+    if (direct.width != cached.width || direct.height != cached.height) {
+        differences = -1;
+    }
+    else {
+        const unsigned char* a = (const unsigned char*)direct.data;
+        const unsigned char* b = (const unsigned char*)cached.data;
+        for (int i = 0; i < direct.width * direct.height; i++) {
+            if (a[i * 4] != b[i * 4] || a[i * 4 + 1] != b[i * 4 + 1] || a[i * 4 + 2] != b[i * 4 + 2]) differences++;  // RGB only, the window has no alpha
         }
+    }
+    UnloadImage(direct);
+    UnloadImage(cached);
+
+    printf("%-24s %s (%d pixels differ)\n", name, differences == 0 ? "ok" : "FAILED", differences);
+    return differences == 0 ? 0 : 1;
+}
+
+// Play a few guesses of a game with the built-in words and compare its screen
+template <class Game>
+int CompareGameScreen(const char* name, Game& game, int guesses) {
+    const int L = Game::LENGTH;
+    const std::vector<std::string>& words = BuiltInWords(L);
+    for (int g = 0; g < guesses && !game.IsOver(); g++) game.Submit(words[(g * 5 + 3) % words.size()].c_str());
+    game.TypeLetter(words[0][0]);  // Something in the current row too
+    const BoardLayout layout = MakeBoardLayout(L, Game::BOARDS, Game::GUESSES);
+    HintView hintView;
+    GameTexts texts;
+    PlayerStats playerStats = {};
+    playerStats.games = 12;  // Show the totals on finished games
+    playerStats.totalScore = 900;
+    playerStats.currentStreak = 3;
+    return CompareCachedScreen(name, [&]() { DrawGame(game, layout, hintView, playerStats, texts); });
+}
+
+// Check that every screen looks the same cached and drawn directly, and that an idle screen is
+// not redrawn. Needs a window, so run it under Xvfb on machines without a display:
+//   xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 ./Codeholics --render-check
+int RunRenderCheck() {
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Wordle render check");
+    int failures = 0;
+    failures += CompareCachedScreen("main menu", []() { DisplayMainMenu(2, false, 6, 4); });
+    failures += CompareCachedScreen("how to play", DisplayHowToPlay);
+    failures += CompareCachedScreen("about us", DisplayAboutUs);
+    PlayerStats stats = {};
+    stats.games = 40;
+    stats.wins = 31;
+    stats.histogram[0] = 9;
+    stats.histogram[4] = 17;
+    stats.histogram[9] = 14;
+    std::vector<PlayerStats> top(3, stats);
+    failures += CompareCachedScreen("statistics", [&]() { DisplayStats(true, stats, top); });
+
+    GameWords classicWords;
+    classicWords.answers = fallbackAnswers[WORD_LENGTH].View();  // No dictionary, so the built-in guesses are accepted
+    ClassicGame classic(classicWords, 1);
+    failures += CompareGameScreen("classic game", classic, 3);
+    ClassicGame finished(classicWords, 2);
+    failures += CompareGameScreen("classic game over", finished, ClassicGame::GUESSES);
 
-        EndDrawing();  // End drawing frame
+    GameWords longWords;
+    longWords.answers = fallbackAnswers[8].View();
+    GameCore<8, 8> octo(longWords, 3);
+    failures += CompareGameScreen("8 boards of 8 letters", octo, 4);
+    AbsurdleCore<6> absurdle(GetGameWords(6));
+    failures += CompareGameScreen("absurdle", absurdle, 0);
+
+    // Frames without changes must only copy the cached screen
+    {
+        CachedScreen idleScreen;  // Scoped so its texture is unloaded while the window still exists
+        for (int frame = 0; frame < 30; frame++) {
+            ShowScreen(idleScreen, false, DisplayHowToPlay);  // Not idle, or the frame would wait for input
+        }
+        bool idleOk = idleScreen.Rebuilds() == 1;
+        printf("%-24s %s (drawn %d times in 30 frames)\n", "idle frames", idleOk ? "ok" : "FAILED", idleScreen.Rebuilds());
+        failures += idleOk ? 0 : 1;
     }
+
+    CloseWindow();
+    return failures == 0 ? 0 : 1;
 }
 
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    PROFILE_THREAD_NAME("Main");  // Label the game loop in traces
+
+    // Convert word lists instead of starting the game: --build-dict <answers.txt> [allowed.txt] <output.cdict>
+    if (argc >= 4 && std::string(argv[1]) == "--build-dict") {
+        std::string error;
+        std::string guessesPath = (argc >= 5) ? argv[3] : "";
+        if (!BuildDictionary(argv[2], guessesPath, argv[argc - 1], error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        printf("Wrote %s\n", argv[argc - 1]);
+        return 0;
+    }
+
+    // Whose statistics to keep: --player NAME, otherwise the name of the logged-in user
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--player") playerName = argv[i + 1];
+    }
+    if (playerName == "PLAYER") {
+        std::string user = EnvironmentVariable("USERNAME");
+        if (user.empty()) user = EnvironmentVariable("USER");
+        if (!user.empty()) playerName = user;
+    }
+
+    LoadDictionaries();  // Map the word lists before the window opens
+
+    // Compare the cached screens with direct drawing and exit (e.g. under Xvfb): --render-check
+    if (argc >= 2 && std::string(argv[1]) == "--render-check") {
+        return RunRenderCheck();
+    }
+
+    GetSolver<WORD_LENGTH>();  // Start looking for the classic opening hint in the background
+
+    // Only the games since the last compaction are read, so this is quick however many were played
+    std::string statsError;
+    if (!statsStore.Open("stats", statsError)) {
+        TraceLog(LOG_WARNING, "STATS: %s, games will not be saved", statsError.c_str());
+    }
+
     // Initialize the Raylib window
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Wordle with Menu and Scoring");
     SetTargetFPS(60);  // Set frame rate to 60 FPS
 
     int menuOption = 0;  // Variable to keep track of the currently selected menu option
+    bool absurdle = false;  // Play the adversarial mode instead of the classic one
+    int wordLength = WORD_LENGTH;  // Letters per word of the next game
+    int boardOption = 0;  // Index in BOARD_COUNTS of the next game's number of boards
+    CachedScreen menuScreen;  // Redrawn when the selection changes
+    CachedScreen howToPlayScreen;  // Static screens are drawn once
+    CachedScreen aboutUsScreen;
+    CachedScreen statsScreen;  // Redrawn every time it is opened, the statistics change between games
 
     while (!WindowShouldClose()) {  // Main menu loop
+        const int menuState = menuOption + 8 * (wordLength + 16 * (boardOption + 8 * absurdle));  // Everything the menu shows
         // Handle menu navigation
-        if (IsKeyPressed(KEY_UP)) menuOption = (menuOption > 0) ? menuOption - 1 : 3; // Move up, wrapping to last option
-        if (IsKeyPressed(KEY_DOWN)) menuOption = (menuOption < 3) ? menuOption + 1 : 0; // Move down, wrapping to first option
+        {
+            PROFILE_SCOPE("Menu input");
+            if (IsKeyPressed(KEY_UP)) menuOption = (menuOption > 0) ? menuOption - 1 : MENU_OPTION_COUNT - 1; // Move up, wrapping to last option
+            if (IsKeyPressed(KEY_DOWN)) menuOption = (menuOption < MENU_OPTION_COUNT - 1) ? menuOption + 1 : 0; // Move down, wrapping to first option
+
+            // Change the game variant with LEFT and RIGHT, wrapping around
+            int change = (IsKeyPressed(KEY_RIGHT) ? 1 : 0) - (IsKeyPressed(KEY_LEFT) ? 1 : 0);
+            if (change != 0 && menuOption == 1) {  // MODE option
+                absurdle = !absurdle;
+            }
+            if (change != 0 && menuOption == 2) {  // WORD LENGTH option
+                int lengths = MAX_WORD_LENGTH - MIN_WORD_LENGTH + 1;
+                wordLength = MIN_WORD_LENGTH + (wordLength - MIN_WORD_LENGTH + change + lengths) % lengths;
+            }
+            if (change != 0 && menuOption == 3 && !absurdle) {  // BOARDS option
+                boardOption = (boardOption + change + BOARD_COUNT_OPTIONS) % BOARD_COUNT_OPTIONS;
+            }
+        }
+
         if (IsKeyPressed(KEY_ENTER)) {  // Handle menu option selection
             if (menuOption == 0) {  // PLAY option
-                RunGame();  // Start the game
+                PlayVariant(absurdle, wordLength, BOARD_COUNTS[boardOption]);  // Start the game
+            }
+            else if (menuOption == 4) {  // HOW TO PLAY option
+                while (!WindowShouldClose()) {
+                    if (IsKeyPressed(KEY_ESCAPE)) break;  // Return to menu if ESC is pressed
+                    ShowScreen(howToPlayScreen, true, DisplayHowToPlay);  // Show "How to Play" instructions
+                }
             }
-            else if (menuOption == 1) {  // HOW TO PLAY option
+            else if (menuOption == 5) {  // STATISTICS option
+                PlayerStats stats = {};
+                std::vector<PlayerStats> top;
+                statsStore.Find(playerName, stats);
+                statsStore.TopPlayers(5, top);
+                statsScreen.Invalidate();
                 while (!WindowShouldClose()) {
                     if (IsKeyPressed(KEY_ESCAPE)) break;  // Return to menu if ESC is pressed
-                    BeginDrawing();
-                    DisplayHowToPlay();  // Show "How to Play" instructions
-                    EndDrawing();
+                    ShowScreen(statsScreen, true, [&]() { DisplayStats(statsStore.IsOpen(), stats, top); });
                 }
             }
-            else if (menuOption == 2) {  // ABOUT US option
+            else if (menuOption == 6) {  // ABOUT US option
                 while (!WindowShouldClose()) {
                     if (IsKeyPressed(KEY_ESCAPE)) break;  // Return to menu if ESC is pressed
-                    BeginDrawing();
-                    DisplayAboutUs();  // Show "About Us" information
-                    EndDrawing();
+                    ShowScreen(aboutUsScreen, true, DisplayAboutUs);  // Show "About Us" information
                 }
             }
-            else if (menuOption == 3) {  // EXIT option
+            else if (menuOption == 7) {  // EXIT option
                 return 0;  // Exit the program
             }
         }
 
         // Draw the main menu screen
-        BeginDrawing();
-        DisplayMainMenu(menuOption);  // Show the menu with the selected option highlighted
-        EndDrawing();
+        if (menuOption + 8 * (wordLength + 16 * (boardOption + 8 * absurdle)) != menuState) menuScreen.Invalidate();
+        ShowScreen(menuScreen, true, [&]() {
+            PROFILE_SCOPE("Draw menu");
+            DisplayMainMenu(menuOption, absurdle, wordLength, BOARD_COUNTS[boardOption]);  // Show the menu with the selected option highlighted
+        });
     }
+    TraceLog(LOG_INFO, "RENDER: %d frames, menu drawn %d times", framePacer.Frames(), menuScreen.Rebuilds());
 
     // Cleanup: Close the Raylib window
     return 0;  // Exit the program
@@ -0,0 +1,395 @@
+#include "GameServer.h"
+#include <algorithm>       // For std::min
+#include <arpa/inet.h>     // For htons and htonl
+#include <cerrno>          // For errno
+#include <cstdarg>         // For formatting responses
+#include <cstdio>          // For vsnprintf
+#include <cstring>         // For memchr, memmove and strerror
+#include <netinet/in.h>    // For sockaddr_in
+#include <netinet/tcp.h>   // For TCP_NODELAY
+#include <new>             // For placement new
+#include <random>          // For picking answers
+#include <sys/epoll.h>     // For the event loop
+#include <sys/socket.h>    // For sockets
+#include <unistd.h>        // For read and close
+
+static const size_t INPUT_CAPACITY = 256;    // Longest request line (with its newline)
+static const size_t OUTPUT_CAPACITY = 1024;  // Responses waiting to be sent
+static const size_t MAX_RESPONSE = 64;       // Longest response line
+static const size_t SESSION_CHUNK = 1024;    // Sessions the pool allocates at a time
+static const int MAX_EVENTS = 256;           // Events handled per epoll_wait
+static const int WAIT_MILLISECONDS = 100;    // How often an idle shard checks the stop flag
+
+// State of one connection: its game and its request and response buffers
+struct Session {
+    explicit Session(const GameWords& words) : game(words, 0) {}
+
+    ClassicGame game;
+    int fd = -1;                  // Socket, -1 while the session is in the free list
+    uint16_t inputLength = 0;     // Bytes received but not handled yet
+    uint16_t outputLength = 0;    // Bytes of responses in `output`
+    uint16_t outputSent = 0;      // Bytes of `output` already sent
+    bool writing = false;         // Waiting for the socket to take the rest of the output (EPOLLOUT)
+    bool closing = false;         // Close once the output is sent (after QUIT)
+    Session* nextFree = nullptr;  // Next session in the pool's free list
+    char input[INPUT_CAPACITY];
+    char output[OUTPUT_CAPACITY];
+};
+
+// Arena of sessions. Memory is taken SESSION_CHUNK sessions at a time and kept until the pool is
+// destroyed; closed sessions go to a free list and are reused by the next connection.
+class SessionPool {
+public:
+    SessionPool(const GameWords& words, size_t capacity) : words(words), capacity(capacity) {
+        chunks.reserve(capacity / SESSION_CHUNK + 1);  // Growing never reallocates the chunk list
+    }
+
+    ~SessionPool() {
+        for (Session* chunk : chunks) {
+            for (size_t i = 0; i < SESSION_CHUNK; i++) chunk[i].~Session();
+            ::operator delete(chunk);
+        }
+    }
+
+    SessionPool(const SessionPool&) = delete;
+    SessionPool& operator=(const SessionPool&) = delete;
+
+    // Take a session, nullptr if the pool is full
+    Session* Acquire() {
+        if (freeList == nullptr && !Grow()) return nullptr;
+        Session* session = freeList;
+        freeList = session->nextFree;
+        return session;
+    }
+
+    void Release(Session* session) {
+        session->fd = -1;
+        session->nextFree = freeList;
+        freeList = session;
+    }
+
+    // Call `visit` for every session with an open connection
+    template <class Visit>
+    void ForEachOpen(Visit visit) {
+        for (Session* chunk : chunks) {
+            for (size_t i = 0; i < SESSION_CHUNK; i++) {
+                if (chunk[i].fd >= 0) visit(&chunk[i]);
+            }
+        }
+    }
+
+private:
+    bool Grow() {
+        if (chunks.size() * SESSION_CHUNK >= capacity) return false;
+        Session* chunk = static_cast<Session*>(::operator new(sizeof(Session) * SESSION_CHUNK));
+        for (size_t i = SESSION_CHUNK; i-- > 0;) {
+            new (&chunk[i]) Session(words);
+            chunk[i].nextFree = freeList;
+            freeList = &chunk[i];
+        }
+        chunks.push_back(chunk);
+        return true;
+    }
+
+    GameWords words;
+    size_t capacity;                // Most sessions the pool hands out
+    std::vector<Session*> chunks;   // Every chunk allocated so far
+    Session* freeList = nullptr;
+};
+
+// One event loop with its own sessions. Only the shard's thread touches its sessions.
+class GameServer::Shard {
+public:
+    Shard(const GameWords& words, size_t maxSessions, uint32_t seed)
+        : words(words), pool(words, maxSessions), random(seed) {}
+
+    ~Shard() {
+        pool.ForEachOpen([](Session* session) { close(session->fd); });
+        if (listenFd >= 0) close(listenFd);
+        if (epollFd >= 0) close(epollFd);
+    }
+
+    // Open this shard's listening socket (shared with the other shards through SO_REUSEPORT)
+    bool Listen(uint16_t port, std::string& error) {
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (listenFd < 0 || epollFd < 0) {
+            error = std::string("Cannot create a socket: ") + strerror(errno);
+            return false;
+        }
+
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if (bind(listenFd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, SOMAXCONN) != 0) {
+            error = "Cannot listen on port " + std::to_string(port) + ": " + strerror(errno);
+            return false;
+        }
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;  // The only event without a session
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+        return true;
+    }
+
+    // Serve connections until `stopping` is set
+    void Run(const std::atomic<bool>& stopping) {
+        epoll_event events[MAX_EVENTS];
+        while (!stopping.load(std::memory_order_relaxed)) {
+            int count = epoll_wait(epollFd, events, MAX_EVENTS, WAIT_MILLISECONDS);
+            for (int i = 0; i < count; i++) {
+                Session* session = (Session*)events[i].data.ptr;
+                if (session == nullptr) Accept();
+                else if (session->writing && (events[i].events & EPOLLOUT)) OnWritable(session);
+                else OnReadable(session);  // Also reports errors and hang-ups through read()
+            }
+
+            // Publish the counters once per batch instead of once per request
+            sessionsShown.store(sessionCount, std::memory_order_relaxed);
+            requestsShown.store(requestCount, std::memory_order_relaxed);
+            guessesShown.store(guessCount, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> sessionsShown{ 0 };  // Counters for Stats(), updated by the shard's thread
+    std::atomic<uint64_t> requestsShown{ 0 };
+    std::atomic<uint64_t> guessesShown{ 0 };
+
+private:
+    // Take every waiting connection
+    void Accept() {
+        for (;;) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                return;  // No more connections (or out of file descriptors until some close)
+            }
+            Session* session = pool.Acquire();
+            if (session == nullptr) {
+                close(fd);  // The shard is full
+                continue;
+            }
+
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));  // Responses are tiny, send them at once
+            session->fd = fd;
+            session->inputLength = 0;
+            session->outputLength = 0;
+            session->outputSent = 0;
+            session->writing = false;
+            session->closing = false;
+            NewGame(session);
+
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.ptr = session;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            sessionCount++;
+        }
+    }
+
+    void OnReadable(Session* session) {
+        ssize_t received = read(session->fd, session->input + session->inputLength, INPUT_CAPACITY - session->inputLength);
+        if (received < 0 && (errno == EAGAIN || errno == EINTR)) return;
+        if (received <= 0) {
+            Close(session);  // The client left (or the connection broke)
+            return;
+        }
+        session->inputLength += (uint16_t)received;
+        HandleInput(session);
+    }
+
+    void OnWritable(Session* session) {
+        if (Flush(session) && !session->writing) HandleInput(session);  // Answer the requests that waited for room
+    }
+
+    // Answer every complete line, sending the responses whenever the output fills up. Stops early
+    // only when the client does not take its responses; OnWritable continues from there.
+    void HandleInput(Session* session) {
+        size_t start = 0;
+        while (!session->closing) {
+            if (OUTPUT_CAPACITY - session->outputLength < MAX_RESPONSE) {
+                if (!Flush(session)) return;  // The connection broke
+                if (session->writing) break;  // The socket is full
+            }
+            char* line = session->input + start;
+            char* newline = (char*)memchr(line, '\n', session->inputLength - start);
+            if (newline == nullptr) break;
+            HandleLine(session, line, newline - line);
+            start = newline - session->input + 1;
+        }
+        memmove(session->input, session->input + start, session->inputLength - start);  // Keep the unanswered lines
+        session->inputLength -= (uint16_t)start;
+
+        if (session->inputLength == INPUT_CAPACITY && memchr(session->input, '\n', INPUT_CAPACITY) == nullptr) {
+            Respond(session, "ERR LINE_TOO_LONG\n");  // A full buffer without a newline can never become a request
+            session->closing = true;
+        }
+        Flush(session);
+    }
+
+    // Answer one request
+    void HandleLine(Session* session, char* line, size_t length) {
+        if (length > 0 && line[length - 1] == '\r') length--;  // Accept telnet-style line endings
+        for (size_t i = 0; i < length; i++) {
+            if (line[i] >= 'a' && line[i] <= 'z') line[i] -= 32;  // Commands and words are not case sensitive
+        }
+        requestCount++;
+
+        ClassicGame& game = session->game;
+        if (length > 6 && memcmp(line, "GUESS ", 6) == 0) {
+            if (length - 6 != (size_t)WORD_LENGTH) {
+                Respond(session, "ERR LENGTH\n");
+                return;
+            }
+            GuessResult result = game.Submit(line + 6);
+            if (result == GuessResult::GameOver) Respond(session, "ERR GAME_OVER\n");
+            else if (result == GuessResult::NotInWordList) Respond(session, "ERR NOT_IN_WORD_LIST\n");
+            else if (result == GuessResult::Incomplete) Respond(session, "ERR LENGTH\n");
+            else {
+                guessCount++;
+                char pattern[WORD_LENGTH + 1];  // One digit per letter
+                const int feedback = game.Feedback(game.GuessCount() - 1, 0);
+                for (int i = 0; i < WORD_LENGTH; i++) pattern[i] = (char)('0' + PatternFeedback(feedback, i));
+                pattern[WORD_LENGTH] = '\0';
+
+                if (game.IsWon()) Respond(session, "WIN %s %d\n", pattern, game.Score());
+                else if (game.IsOver()) Respond(session, "LOSE %s %s\n", pattern, game.Answer(0));
+                else Respond(session, "FEEDBACK %s %d\n", pattern, ClassicGame::GUESSES - game.GuessCount());
+            }
+        }
+        else if (length == 3 && memcmp(line, "NEW", 3) == 0) {
+            NewGame(session);
+            Respond(session, "READY %d\n", ClassicGame::GUESSES);
+        }
+        else if (length == 5 && memcmp(line, "SCORE", 5) == 0) {
+            Respond(session, "SCORE %d\n", game.Score());
+        }
+        else if (length == 4 && memcmp(line, "QUIT", 4) == 0) {
+            Respond(session, "BYE\n");
+            session->closing = true;
+        }
+        else {
+            Respond(session, "ERR UNKNOWN_COMMAND\n");
+        }
+    }
+
+    // Pick a new answer with the shard's generator (one generator for all sessions of the shard)
+    void NewGame(Session* session) {
+        std::uniform_int_distribution<size_t> pick(0, words.answers.count - 1);
+        const size_t index = pick(random);
+        char chosen[WORD_LENGTH];
+        for (int i = 0; i < WORD_LENGTH; i++) chosen[i] = (char)words.answers.letters[i * words.answers.stride + index];
+        session->game.NewGame(chosen);
+    }
+
+    // Add a response line to the session's output (the caller made sure MAX_RESPONSE bytes are free)
+    static void Respond(Session* session, const char* format, ...) {
+        va_list arguments;
+        va_start(arguments, format);
+        int written = vsnprintf(session->output + session->outputLength, OUTPUT_CAPACITY - session->outputLength, format, arguments);
+        va_end(arguments);
+        if (written > 0) session->outputLength = (uint16_t)std::min<size_t>(session->outputLength + written, OUTPUT_CAPACITY);
+    }
+
+    // Send as much output as the socket takes; returns false if the session was closed
+    bool Flush(Session* session) {
+        while (session->outputSent < session->outputLength) {
+            ssize_t sent = send(session->fd, session->output + session->outputSent, session->outputLength - session->outputSent, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN) break;
+                Close(session);
+                return false;
+            }
+            session->outputSent += (uint16_t)sent;
+        }
+
+        if (session->outputSent == session->outputLength) {
+            session->outputLength = 0;
+            session->outputSent = 0;
+            if (session->closing) {
+                Close(session);
+                return false;
+            }
+            if (session->writing) Watch(session, false);  // Everything is sent, read requests again
+        }
+        else if (!session->writing) {
+            Watch(session, true);  // Stop reading until the client takes its responses
+        }
+        return true;
+    }
+
+    // Switch between waiting for requests and waiting for room to send
+    void Watch(Session* session, bool writing) {
+        epoll_event event = {};
+        event.events = writing ? EPOLLOUT : EPOLLIN;
+        event.data.ptr = session;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, session->fd, &event);
+        session->writing = writing;
+    }
+
+    void Close(Session* session) {
+        close(session->fd);  // Also removes it from the epoll set
+        pool.Release(session);
+        sessionCount--;
+    }
+
+    GameWords words;
+    SessionPool pool;
+    std::minstd_rand random;  // Picks the answers of this shard's games
+    int listenFd = -1;
+    int epollFd = -1;
+    uint64_t sessionCount = 0;  // Counters owned by the shard's thread
+    uint64_t requestCount = 0;
+    uint64_t guessCount = 0;
+};
+
+GameServer::GameServer(const GameWords& words) : words(words), stopping(false) {}
+
+GameServer::~GameServer() {
+    Stop();
+}
+
+bool GameServer::Start(const ServerOptions& options, std::string& error) {
+    int shardCount = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    if (shardCount <= 0) shardCount = 1;
+
+    std::random_device seeds;
+    for (int i = 0; i < shardCount; i++) {
+        shards.emplace_back(new Shard(words, options.maxSessionsPerShard, seeds()));
+        if (!shards.back()->Listen(options.port, error)) {
+            shards.clear();
+            return false;
+        }
+    }
+
+    stopping = false;
+    for (auto& shard : shards) {
+        Shard* running = shard.get();
+        threads.emplace_back([this, running]() { running->Run(stopping); });
+    }
+    return true;
+}
+
+void GameServer::Stop() {
+    stopping = true;
+    for (std::thread& thread : threads) thread.join();
+    threads.clear();
+    shards.clear();  // Closes every connection
+}
+
+ServerStats GameServer::Stats() const {
+    ServerStats stats;
+    for (const auto& shard : shards) {
+        stats.sessions += shard->sessionsShown.load(std::memory_order_relaxed);
+        stats.requests += shard->requestsShown.load(std::memory_order_relaxed);
+        stats.guesses += shard->guessesShown.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
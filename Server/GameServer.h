@@ -0,0 +1,62 @@
+#pragma once
+#include "GameCore.h"  // The game rules every session plays by
+#include <atomic>      // For the stop flag and the counters
+#include <cstdint>     // For uint16_t and uint64_t
+#include <memory>      // For std::unique_ptr
+#include <string>      // For error messages
+#include <thread>      // For the shard threads
+#include <vector>      // For the shards
+
+// Line protocol spoken by the server. Every request is one line, every response is one line:
+//
+//   NEW            ->  READY <guesses allowed>             start a new game (the score is kept)
+//   GUESS <word>   ->  FEEDBACK <pattern> <guesses left>   pattern has one digit per letter:
+//                  ->  WIN <pattern> <score>               0 absent, 1 present, 2 correct
+//                  ->  LOSE <pattern> <answer>
+//                  ->  ERR LENGTH | ERR NOT_IN_WORD_LIST | ERR GAME_OVER
+//   SCORE          ->  SCORE <score>
+//   QUIT           ->  BYE (then the server closes the connection)
+//   anything else  ->  ERR UNKNOWN_COMMAND
+//
+// A game starts as soon as a client connects, so the first request can be a guess.
+
+// Settings of a server
+struct ServerOptions {
+    uint16_t port = 7000;                 // TCP port to listen on (all interfaces)
+    int threads = 0;                      // Shards, each on its own thread and core (0 = one per core)
+    size_t maxSessionsPerShard = 65536;   // Connections above this are closed right away
+};
+
+// Counters of a running server, summed over the shards
+struct ServerStats {
+    uint64_t sessions = 0;   // Connections open right now
+    uint64_t requests = 0;   // Lines answered
+    uint64_t guesses = 0;    // Guesses scored
+};
+
+// Plays many games at once over TCP (Linux, epoll). The sessions are split into shards, one per
+// thread: every shard has its own listening socket on the same port (SO_REUSEPORT, so the kernel
+// spreads new connections), its own epoll loop and its own session pool, so shards never share
+// anything but the read-only word lists. Session state comes from the pool and requests are
+// parsed and answered in fixed per-session buffers, so serving a request never allocates.
+class GameServer {
+public:
+    explicit GameServer(const GameWords& words);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    bool Start(const ServerOptions& options, std::string& error);  // Open the sockets and start the shards
+    void Stop();                                                    // Close every connection and wait for the shards
+    ServerStats Stats() const;
+    int ShardCount() const { return (int)shards.size(); }
+
+private:
+    class Shard;
+
+    GameWords words;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping;
+};
@@ -0,0 +1,216 @@
+#include "LoadClient.h"
+#include "Scoring.h"       // For WORD_LENGTH
+#include <arpa/inet.h>     // For inet_pton
+#include <atomic>          // For the shared failure flag
+#include <cerrno>          // For errno
+#include <chrono>          // For latencies
+#include <cstring>         // For memchr and memcmp
+#include <netinet/in.h>    // For sockaddr_in
+#include <netinet/tcp.h>   // For TCP_NODELAY
+#include <random>          // For picking guesses
+#include <sys/epoll.h>     // For the event loop
+#include <sys/socket.h>    // For sockets
+#include <thread>          // For the client threads
+#include <unistd.h>        // For read and close
+#include <vector>          // For connections and threads
+
+typedef std::chrono::steady_clock Clock;
+
+// Latencies counted in buckets that are at most 1/16 wide relative to their value, so
+// percentiles are accurate to about 6% without keeping every sample
+class LatencyHistogram {
+public:
+    void Add(uint64_t nanoseconds) {
+        counts[Bucket(nanoseconds)]++;
+        total++;
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKETS; i++) counts[i] += other.counts[i];
+        total += other.total;
+    }
+
+    // Upper end of the bucket holding the given fraction of the samples, in nanoseconds
+    uint64_t Percentile(double fraction) const {
+        uint64_t rank = (uint64_t)(fraction * total);
+        if (rank >= total) rank = total - 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen > rank) return UpperEnd(i);
+        }
+        return 0;
+    }
+
+    uint64_t Count() const { return total; }
+
+private:
+    static const int SUB_BUCKETS = 16;  // Buckets per power of two
+    static const int BUCKETS = 64 * SUB_BUCKETS;
+
+    // Values below 16 get a bucket each, larger ones keep their top 5 bits
+    static int Bucket(uint64_t value) {
+        if (value < SUB_BUCKETS) return (int)value;
+        int top = 63 - __builtin_clzll(value);  // Position of the highest set bit (4 or more)
+        return (top - 3) * SUB_BUCKETS + (int)((value >> (top - 4)) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t UpperEnd(int bucket) {
+        if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+        int top = bucket / SUB_BUCKETS + 3;
+        uint64_t lower = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << (top - 4);
+        return lower + ((uint64_t)1 << (top - 4)) - 1;
+    }
+
+    uint64_t counts[BUCKETS] = { 0 };
+    uint64_t total = 0;
+};
+
+// One client connection with a request in flight
+struct Connection {
+    int fd = -1;
+    Clock::time_point sent;     // When the request in flight was sent
+    size_t inputLength = 0;
+    char input[256];
+};
+
+// Results of one client thread
+struct ThreadResult {
+    LatencyHistogram latencies;
+    uint64_t guesses = 0;
+    uint64_t games = 0;
+    uint64_t errors = 0;
+    std::string error;          // Set if the thread could not run
+};
+
+// Send one request line on a connection that has nothing in flight
+static bool SendRequest(Connection& connection, const char* request, size_t length) {
+    connection.sent = Clock::now();
+    ssize_t sent = send(connection.fd, request, length, MSG_NOSIGNAL);
+    return sent == (ssize_t)length;  // A request always fits in an empty socket buffer
+}
+
+// Send a random guess
+static bool SendGuess(Connection& connection, const char* guesses, size_t guessCount, std::minstd_rand& random) {
+    char request[6 + WORD_LENGTH + 1];
+    memcpy(request, "GUESS ", 6);
+    std::uniform_int_distribution<size_t> pick(0, guessCount - 1);
+    memcpy(request + 6, guesses + pick(random) * WORD_LENGTH, WORD_LENGTH);
+    request[6 + WORD_LENGTH] = '\n';
+    return SendRequest(connection, request, sizeof(request));
+}
+
+// Open `count` connections and keep them busy until `deadline`
+static void RunClientThread(const LoadOptions& options, int count, const char* guesses, size_t guessCount, uint32_t seed,
+    Clock::time_point deadline, ThreadResult& result) {
+    std::minstd_rand random(seed);
+    std::vector<Connection> connections(count);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        result.error = "Not an IPv4 address: " + options.host;
+        close(epollFd);
+        return;
+    }
+
+    for (Connection& connection : connections) {
+        connection.fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (connection.fd < 0 || connect(connection.fd, (const sockaddr*)&address, sizeof(address)) != 0) {
+            result.error = "Cannot connect to " + options.host + ":" + std::to_string(options.port) + ": " + strerror(errno);
+            break;
+        }
+        int one = 1;
+        setsockopt(connection.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = &connection;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, connection.fd, &event);
+        SendGuess(connection, guesses, guessCount, random);  // A game is already running after connecting
+    }
+
+    epoll_event events[256];
+    while (result.error.empty() && Clock::now() < deadline) {
+        int ready = epoll_wait(epollFd, events, 256, 100);
+        const Clock::time_point now = Clock::now();
+        for (int i = 0; i < ready; i++) {
+            Connection& connection = *(Connection*)events[i].data.ptr;
+            ssize_t received = read(connection.fd, connection.input + connection.inputLength, sizeof(connection.input) - connection.inputLength);
+            if (received <= 0) {
+                result.error = "The server closed a connection";
+                break;
+            }
+            connection.inputLength += (size_t)received;
+
+            // There is one request in flight, so there is at most one response
+            char* newline = (char*)memchr(connection.input, '\n', connection.inputLength);
+            if (newline == nullptr) continue;
+            result.latencies.Add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - connection.sent).count());
+            const char* line = connection.input;
+            bool newGame = false;
+            if (memcmp(line, "FEEDBACK", 8) == 0) result.guesses++;
+            else if (memcmp(line, "WIN", 3) == 0 || memcmp(line, "LOSE", 4) == 0) {
+                result.guesses++;
+                result.games++;
+                newGame = true;
+            }
+            else if (memcmp(line, "ERR GAME_OVER", 13) == 0) newGame = true;
+            else if (memcmp(line, "ERR", 3) == 0) result.errors++;  // E.g. a guess the server's dictionary does not have
+            connection.inputLength = 0;
+
+            bool sent = newGame ? SendRequest(connection, "NEW\n", 4) : SendGuess(connection, guesses, guessCount, random);
+            if (!sent) {
+                result.error = "Cannot send a request";
+                break;
+            }
+        }
+    }
+
+    for (Connection& connection : connections) {
+        if (connection.fd >= 0) close(connection.fd);
+    }
+    close(epollFd);
+}
+
+bool RunLoad(const LoadOptions& options, const char* guesses, size_t guessCount, LoadReport& report, std::string& error) {
+    const int threadCount = options.threads > 0 ? options.threads : 1;
+    std::vector<ThreadResult> results(threadCount);
+    std::vector<std::thread> threads;
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline = start + std::chrono::microseconds((long long)(options.seconds * 1e6));
+    for (int t = 0; t < threadCount; t++) {
+        int count = options.connections / threadCount + (t < options.connections % threadCount ? 1 : 0);  // Spread the connections evenly
+        threads.emplace_back(RunClientThread, std::cref(options), count, guesses, guessCount, options.seed + t, deadline, std::ref(results[t]));
+    }
+    for (std::thread& thread : threads) thread.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    LatencyHistogram latencies;
+    report = LoadReport();
+    for (const ThreadResult& result : results) {
+        if (!result.error.empty()) {
+            error = result.error;
+            return false;
+        }
+        latencies.Merge(result.latencies);
+        report.guesses += result.guesses;
+        report.games += result.games;
+        report.errors += result.errors;
+    }
+    if (latencies.Count() == 0) {
+        error = "The server did not answer";
+        return false;
+    }
+
+    report.requests = latencies.Count();
+    report.seconds = seconds;
+    report.p50 = latencies.Percentile(0.50) / 1000.0;
+    report.p99 = latencies.Percentile(0.99) / 1000.0;
+    report.p999 = latencies.Percentile(0.999) / 1000.0;
+    report.max = latencies.Percentile(1.0) / 1000.0;
+    return true;
+}
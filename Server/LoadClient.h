@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint16_t and uint64_t
+#include <string>   // For the host name and error messages
+
+// Settings of a load test
+struct LoadOptions {
+    std::string host = "127.0.0.1";  // Server address (IPv4)
+    uint16_t port = 7000;
+    int threads = 1;                 // Client threads, each with its own epoll loop
+    int connections = 64;            // Connections over all threads, each with one request in flight
+    double seconds = 10.0;           // How long to send requests
+    uint32_t seed = 12345;           // For picking guesses
+};
+
+// Results of a load test
+struct LoadReport {
+    uint64_t requests = 0;   // Responses received
+    uint64_t guesses = 0;    // Guesses the server scored
+    uint64_t games = 0;      // Games that ended (won or lost)
+    uint64_t errors = 0;     // ERR responses other than GAME_OVER
+    double seconds = 0.0;    // Time the requests were sent for
+    double p50 = 0.0;        // Request latency percentiles in microseconds
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+};
+
+// Play games against a server as fast as it answers: every connection sends one request, waits
+// for the response, and sends the next (random guesses until the game ends, then NEW). `guesses`
+// holds `guessCount` WORD_LENGTH-letter words back to back.
+bool RunLoad(const LoadOptions& options, const char* guesses, size_t guessCount, LoadReport& report, std::string& error);
@@ -0,0 +1,131 @@
+// Game server: plays the classic game for many clients at once over a line-based TCP protocol
+// (see GameServer.h), plus a load generator that measures its throughput and latency.
+//
+// Linux only (epoll):
+//   g++ -std=c++14 -O2 -pthread -I../Codeholics main.cpp GameServer.cpp LoadClient.cpp ../Codeholics/Scoring.cpp
+//       ../Codeholics/Dictionary.cpp ../Codeholics/MappedFile.cpp ../Codeholics/GameCore.cpp ../Codeholics/ToolWords.cpp
+//       ../Codeholics/AllocCounter.cpp -o server
+//
+// Usage: server [--port 7000] [--threads N] [--dict words5.cdict]                  run the server
+//        server --load [--host 127.0.0.1] [--port 7000] [--threads N] [--connections N] [--seconds S] [--dict words5.cdict]
+//        server --bench [--threads N] [--client-threads N] [--connections N] [--seconds S] [--dict words5.cdict]
+//
+// --bench runs the server and the load generator in one process and also counts heap allocations.
+#include "GameServer.h"    // The server
+#include "LoadClient.h"    // The load generator
+#include "ToolWords.h"     // Word lists from a dictionary file or the built-in list
+#include "AllocCounter.h"  // --bench shows that requests do not allocate
+#include <chrono>          // For the stats interval
+#include <csignal>         // For stopping with Ctrl+C
+#include <cstdio>          // For printing the report
+#include <cstring>         // For strcmp
+#include <string>          // For options
+#include <thread>          // For sleeping between stats lines
+
+static volatile std::sig_atomic_t interrupted = 0;
+
+static void OnInterrupt(int) {
+    interrupted = 1;
+}
+
+static void PrintReport(const LoadReport& report, int connections) {
+    printf("%11s %12s %12s %10s %8s %9s %9s %9s %9s\n", "connections", "requests/s", "guesses/s", "games/s", "errors", "p50 us", "p99 us", "p99.9 us", "max us");
+    printf("%11d %12.0f %12.0f %10.0f %8llu %9.1f %9.1f %9.1f %9.1f\n", connections, report.requests / report.seconds, report.guesses / report.seconds,
+        report.games / report.seconds, (unsigned long long)report.errors, report.p50, report.p99, report.p999, report.max);
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = "serve";
+    std::string dictionaryPath;
+    ServerOptions serverOptions;
+    LoadOptions loadOptions;
+    int threads = 0;
+    int clientThreads = 1;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--load") == 0) mode = "load";
+        else if (strcmp(argv[i], "--bench") == 0) mode = "bench";
+        else if (strcmp(argv[i], "--dict") == 0 && hasValue) dictionaryPath = argv[++i];
+        else if (strcmp(argv[i], "--host") == 0 && hasValue) loadOptions.host = argv[++i];
+        else if (strcmp(argv[i], "--port") == 0 && hasValue) serverOptions.port = loadOptions.port = (uint16_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--client-threads") == 0 && hasValue) clientThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--connections") == 0 && hasValue) loadOptions.connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seconds") == 0 && hasValue) loadOptions.seconds = atof(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--load | --bench] [--dict words5.cdict] [--host H] [--port P] [--threads N] [--client-threads N] [--connections N] [--seconds S]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Use the dictionary if one was given, otherwise the built-in word list
+    ToolWords toolWords;
+    std::string loadError;
+    if (!toolWords.Load(dictionaryPath, loadError)) {
+        fprintf(stderr, "%s\n", loadError.c_str());
+        return 1;
+    }
+    const GameWords& words = toolWords.Game();
+    const char* guesses = toolWords.Guesses();  // What the load generator guesses
+    const size_t guessCount = toolWords.GuessCount();
+
+    if (mode == "load") {
+        loadOptions.threads = threads > 0 ? threads : 1;
+        LoadReport report;
+        std::string error;
+        if (!RunLoad(loadOptions, guesses, guessCount, report, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        PrintReport(report, loadOptions.connections);
+        return 0;
+    }
+
+    GameServer server(words);
+    serverOptions.threads = (mode == "bench" && threads == 0) ? 1 : threads;  // Measure one core unless told otherwise
+    std::string error;
+    if (!server.Start(serverOptions, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    if (mode == "bench") {
+        loadOptions.threads = clientThreads;
+        loadOptions.host = "127.0.0.1";
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));  // Let the shards reach epoll_wait
+        const size_t allocationsBefore = AllocationCount();
+        LoadReport report;
+        bool ok = RunLoad(loadOptions, guesses, guessCount, report, error);
+        const size_t allocations = AllocationCount() - allocationsBefore;
+        const ServerStats stats = server.Stats();
+        const int shardCount = server.ShardCount();
+        server.Stop();
+        if (!ok) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        printf("Server: %d shard(s), %zu answers, %zu guesses; client: %d thread(s)\n", shardCount,
+            words.answers.count, guessCount, clientThreads);
+        PrintReport(report, loadOptions.connections);
+        printf("Server answered %llu requests (%llu guesses); %zu heap allocations during the run (connection setup included)\n",
+            (unsigned long long)stats.requests, (unsigned long long)stats.guesses, allocations);
+        return 0;
+    }
+
+    // Serve until Ctrl+C, printing the counters every few seconds
+    signal(SIGINT, OnInterrupt);
+    signal(SIGTERM, OnInterrupt);
+    printf("Listening on port %d with %d shard(s), %zu answers\n", serverOptions.port, server.ShardCount(), words.answers.count);
+    fflush(stdout);
+    ServerStats last = server.Stats();
+    while (!interrupted) {
+        for (int tick = 0; tick < 50 && !interrupted; tick++) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ServerStats stats = server.Stats();
+        printf("%llu sessions, %.0f requests/s, %.0f guesses/s\n", (unsigned long long)stats.sessions,
+            (stats.requests - last.requests) / 5.0, (stats.guesses - last.guesses) / 5.0);
+        fflush(stdout);
+        last = stats;
+    }
+    server.Stop();
+    return 0;
+}